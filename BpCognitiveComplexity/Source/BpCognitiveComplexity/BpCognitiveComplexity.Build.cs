@@ -21,11 +21,13 @@ public class BpCognitiveComplexity : ModuleRules
 			"Slate",
 			"SlateCore",
 			"ApplicationCore",
+			"AssetRegistry",
 			"UnrealEd",
 			"Kismet",
 			"KismetCompiler",
 			"EditorStyle",
 			"DeveloperSettings",
+			"Json",
 			"KismetWidgets",
 			"ToolMenus"
 		});
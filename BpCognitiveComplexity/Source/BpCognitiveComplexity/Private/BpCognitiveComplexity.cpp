@@ -2,14 +2,27 @@
 
 #include "BpCognitiveComplexity.h"
 
+#include "K2Node_CallFunction.h"
+#include "K2Node_CallMaterialParameterCollectionFunction.h"
 #include "K2Node_Event.h"
 #include "K2Node_FunctionEntry.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MacroInstance.h"
+#include "BlueprintEditorModule.h"
 #include "BpCognitiveComplexitySettings.h"
-#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityAssetTags.h"
+#include "CognitiveComplexityBadgeLayout.h"
+#include "CognitiveComplexityNodeClassifier.h"
+#include "CognitiveComplexityResultCache.h"
+#include "CognitiveComplexityScoreCache.h"
+#include "CognitiveComplexityStats.h"
 #include "Editor.h"
 #include "EdGraph/EdGraph.h"
 #include "Engine/Blueprint.h"
 #include "EdGraphUtilities.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/CoreDelegates.h"
+#include "Subsystems/AssetEditorSubsystem.h"
 #include "Styling/AppStyle.h"
 #include "KismetNodes/SGraphNodeK2Default.h"
 #include "Framework/Application/SlateApplication.h"
@@ -22,6 +35,10 @@
 #include "ToolMenus.h"
 #include "CognitiveComplexityDashboard.h"
 
+DEFINE_LOG_CATEGORY(LogBpCognitiveComplexity);
+DEFINE_STAT(STAT_BpCognitiveComplexity_BadgePaint);
+DEFINE_STAT(STAT_BpCognitiveComplexity_HeatmapPaint);
+
 FLinearColor ComplexityColorForPercent(const UBpCognitiveComplexitySettings& Settings, float Percent)
 {
 	// Keep thresholds driven by settings, but always map from green -> amber -> red -> dark maroon.
@@ -67,50 +84,111 @@ public:
 		}
 
 		const UBpCognitiveComplexitySettings* BpCognitiveComplexitySettings = UBpCognitiveComplexitySettings::Get();
-		if (BpCognitiveComplexitySettings == nullptr)
+		if (BpCognitiveComplexitySettings == nullptr || !ComplexityModule->GetShowEntryBadges())
+		{
+			return BaseLayer;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_BadgePaint);
+
+		// Nothing to draw until the entry's first background score lands.
+		const TOptional<FCognitiveComplexityScore> Score = ComplexityModule->GetScoreForNode(*GraphNode);
+		if (!Score.IsSet())
 		{
 			return BaseLayer;
 		}
 
-		const FCognitiveComplexityScore Score = ComplexityModule->GetScoreForNode(*GraphNode);
 		const FSlateFontInfo FontInfo = FAppStyle::GetFontStyle(TEXT("BlueprintEditor.Node.TitleFont"));
-		const FString Label = ComplexityModule->GetComplexityLabelForPercent(Score.Percent, BpCognitiveComplexitySettings);
-		// Prefix with a small diamond-like glyph to subtly echo IDE complexity indicators.
-		const FString Text = FString::Printf(TEXT("◆ %s (%.0f%%)"), *Label, Score.Percent);
-		const FVector2D TextSize = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->Measure(Text, FontInfo);
+		const FCognitiveComplexityBadgeLayout& Badge = BadgeLayoutCache.Get(*ComplexityModule, *BpCognitiveComplexitySettings, ComplexityModule->GetSettingsGeneration(), Score->Percent, FontInfo);
+		const FVector2D TextSize = Badge.TextSize;
 
 		const FVector2D BadgePadding(6.f, 2.f);
 		const FVector2D BadgeSize = TextSize + BadgePadding * 2.0f;
 		const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
 		const FVector2D BadgePos((LocalSize.X - BadgeSize.X) * 0.5f, -BadgeSize.Y - 4.0f);
-		const FVector2f BadgeSizeF(BadgeSize);
 		const FVector2f BadgePosF(BadgePos);
-		
-		int32 CurrentLayer = BaseLayer;
 
-		if (ComplexityModule->GetShowEntryBadges())
+		// Draw only colored text (no filled background) to keep the indicator subtle.
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			BaseLayer + 1,
+			AllottedGeometry.ToPaintGeometry(FVector2f(TextSize), FSlateLayoutTransform(BadgePosF + FVector2f(BadgePadding))),
+			Badge.Text,
+			FontInfo,
+			ESlateDrawEffect::None,
+			Badge.Color
+		);
+
+		return BaseLayer + 1;
+	}
+
+private:
+	FBpCognitiveComplexityModule* ComplexityModule = nullptr;
+
+	/** Painting is const, the cached layout is not part of the widget's observable state. */
+	mutable FCognitiveComplexityBadgeLayoutCache BadgeLayoutCache;
+};
+
+/** Non-entry node that tints itself and shows what it adds to its entry's score while the heatmap is on. */
+class SCognitiveComplexityHeatmapNode : public SGraphNodeK2Default
+{
+public:
+	SLATE_BEGIN_ARGS(SCognitiveComplexityHeatmapNode) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UEdGraphNode* InNode, FBpCognitiveComplexityModule* InModule)
+	{
+		ComplexityModule = InModule;
+		SGraphNodeK2Default::Construct(SGraphNodeK2Default::FArguments(), Cast<UK2Node>(InNode));
+	}
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+	{
+		const int32 BaseLayer = SGraphNodeK2Default::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+		if (ComplexityModule == nullptr || GraphNode == nullptr || !ComplexityModule->GetShowHeatmap())
+		{
+			return BaseLayer;
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_HeatmapPaint);
+
+		const FSlateFontInfo FontInfo = FAppStyle::GetFontStyle(TEXT("BlueprintEditor.Node.TitleFont"));
+		const FCognitiveComplexityHeatLayout& Heat = HeatLayoutCache.Get(*ComplexityModule, *GraphNode, FontInfo);
+		if (!Heat.bVisible)
 		{
-			const FLinearColor BadgeColor = ComplexityColorForPercent(*BpCognitiveComplexitySettings, Score.Percent);
-
-			// Draw only colored text (no filled background) to keep the indicator subtle.
-			FSlateDrawElement::MakeText(
-				OutDrawElements,
-				CurrentLayer + 1,
-				AllottedGeometry.ToPaintGeometry(FVector2f(TextSize), FSlateLayoutTransform(BadgePosF + FVector2f(BadgePadding))),
-				Text,
-				FontInfo,
-				ESlateDrawEffect::None,
-				BadgeColor
-			);
-
-			CurrentLayer += 1;
+			return BaseLayer;
 		}
 
-		return CurrentLayer;
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			BaseLayer + 1,
+			AllottedGeometry.ToPaintGeometry(),
+			FAppStyle::GetBrush(TEXT("WhiteBrush")),
+			ESlateDrawEffect::None,
+			Heat.Tint
+		);
+
+		const FVector2f LabelPos(0.0f, -static_cast<float>(Heat.TextSize.Y) - 4.0f);
+		FSlateDrawElement::MakeText(
+			OutDrawElements,
+			BaseLayer + 1,
+			AllottedGeometry.ToPaintGeometry(FVector2f(Heat.TextSize), FSlateLayoutTransform(LabelPos)),
+			Heat.Text,
+			FontInfo,
+			ESlateDrawEffect::None,
+			Heat.TextColor
+		);
+
+		return BaseLayer + 1;
 	}
 
 private:
 	FBpCognitiveComplexityModule* ComplexityModule = nullptr;
+
+	/** Painting is const, the cached layout is not part of the widget's observable state. */
+	mutable FCognitiveComplexityHeatLayoutCache HeatLayoutCache;
 };
 
 class FCognitiveComplexityNodeFactory : public FGraphPanelNodeFactory
@@ -133,6 +211,16 @@ public:
 			return SNew(SCognitiveComplexityEntryNode, Node, Module);
 		}
 
+		// Only nodes the stock factory would draw with the default K2 widget; compact nodes (math,
+		// array helpers) and nodes with their own widget keep their look and show no heatmap. They
+		// are only claimed while the heatmap is shown, so other factories get them otherwise.
+		const UK2Node* K2Node = Cast<UK2Node>(Node);
+		if (Module->GetShowHeatmap() && K2Node != nullptr && !K2Node->ShouldDrawCompact() && !K2Node->IsA<UK2Node_CallMaterialParameterCollectionFunction>()
+			&& (K2Node->IsA<UK2Node_CallFunction>() || K2Node->IsA<UK2Node_IfThenElse>() || K2Node->IsA<UK2Node_MacroInstance>()))
+		{
+			return SNew(SCognitiveComplexityHeatmapNode, Node, Module);
+		}
+
 		return nullptr;
 	}
 
@@ -142,6 +230,21 @@ private:
 
 void FBpCognitiveComplexityModule::StartupModule()
 {
+	ScoreCache = MakeShared<FCognitiveComplexityScoreCache>();
+	ResultCache = MakeShared<FCognitiveComplexityResultCache>();
+	ResultCache->Load();
+	FCognitiveComplexityAssetTags::Register();
+	SettingsChangedHandle = UBpCognitiveComplexitySettings::OnSettingsChanged().AddRaw(this, &FBpCognitiveComplexityModule::HandleSettingsChanged);
+
+	if (GEditor != nullptr)
+	{
+		BindEditorEvents();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FBpCognitiveComplexityModule::BindEditorEvents);
+	}
+
 	NodeFactory = MakeShared<FCognitiveComplexityNodeFactory>(*this);
 	FEdGraphUtilities::RegisterVisualNodeFactory(NodeFactory);
 
@@ -172,6 +275,18 @@ void FBpCognitiveComplexityModule::StartupModule()
 					EUserInterfaceActionType::ToggleButton
 				);
 
+				SubSection.AddMenuEntry(
+					"BpCognitiveComplexity_ToggleHeatmap",
+					NSLOCTEXT("BpCognitiveComplexity", "ToggleHeatmap", "Show Complexity Heatmap"),
+					NSLOCTEXT("BpCognitiveComplexity", "ToggleHeatmapTooltip", "Toggle a heatmap on Blueprint nodes showing how much each node adds to the complexity of its event or function. Only function calls, branches and macro nodes drawn with the default node widget are tinted; sequences, switches, selects, multi gates, timelines, native loop nodes and compact nodes are not."),
+					FSlateIcon(),
+					FUIAction(
+						FExecuteAction::CreateRaw(this, &FBpCognitiveComplexityModule::ToggleShowHeatmap),
+						FCanExecuteAction(),
+						FGetActionCheckState::CreateRaw(this, &FBpCognitiveComplexityModule::GetShowHeatmapCheckState)),
+					EUserInterfaceActionType::ToggleButton
+				);
+
 				SubSection.AddMenuEntry(
 					"BpCognitiveComplexity_OpenDashboard",
 					NSLOCTEXT("BpCognitiveComplexity", "OpenDashboard", "Open Complexity Dashboard"),
@@ -196,7 +311,33 @@ void FBpCognitiveComplexityModule::ShutdownModule()
 		NodeFactory.Reset();
 	}
 
-	CachedScores.Empty();
+	UBpCognitiveComplexitySettings::OnSettingsChanged().Remove(SettingsChangedHandle);
+	FCognitiveComplexityAssetTags::Unregister();
+
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	if (GEditor != nullptr)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(PreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(CompileHandle);
+
+		if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+		{
+			AssetEditorSubsystem->OnAssetClosedInEditor().Remove(AssetClosedHandle);
+		}
+	}
+	CompilingBlueprints.Empty();
+
+	if (ScoreCache.IsValid())
+	{
+		ScoreCache->Reset();
+		ScoreCache.Reset();
+	}
+
+	if (ResultCache.IsValid())
+	{
+		ResultCache->Save();
+		ResultCache.Reset();
+	}
 
 	FCognitiveComplexityDashboard::UnregisterTabSpawner();
 }
@@ -206,6 +347,30 @@ void FBpCognitiveComplexityModule::ToggleShowEntryBadges()
 	bShowEntryBadges = !bShowEntryBadges;
 }
 
+void FBpCognitiveComplexityModule::ToggleShowHeatmap()
+{
+	bShowHeatmap = !bShowHeatmap;
+
+	// Node widgets are picked when a graph panel is built, so open Blueprint editors rebuild theirs
+	// to switch between the heatmap widgets and the ones other factories provide.
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	if (AssetEditorSubsystem == nullptr)
+	{
+		return;
+	}
+
+	for (UObject* Asset : AssetEditorSubsystem->GetAllEditedAssets())
+	{
+		if (const UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+		{
+			if (const TSharedPtr<IBlueprintEditor> BlueprintEditor = FKismetEditorUtilities::GetIBlueprintEditorForObject(Blueprint, false))
+			{
+				BlueprintEditor->RefreshEditors();
+			}
+		}
+	}
+}
+
 FString FBpCognitiveComplexityModule::GetComplexityLabelForPercent(float Percent, const class UBpCognitiveComplexitySettings* Settings) const
 {
 	if (Settings == nullptr)
@@ -242,111 +407,119 @@ ECheckBoxState FBpCognitiveComplexityModule::GetShowEntryBadgesCheckState() cons
 	return bShowEntryBadges ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
 }
 
-FCognitiveComplexityScore FBpCognitiveComplexityModule::GetScoreForNode(const UEdGraphNode& Node) const
+ECheckBoxState FBpCognitiveComplexityModule::GetShowHeatmapCheckState() const
 {
-	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
-	if (Settings == nullptr)
+	return bShowHeatmap ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+bool FBpCognitiveComplexityModule::GetNodeContribution(const UEdGraphNode& Node, FCognitiveComplexityNodeContribution& OutContribution, float& OutGraphMaxContribution) const
+{
+	if (!ScoreCache.IsValid())
+	{
+		return false;
+	}
+
+	return ScoreCache->GetNodeContribution(Node, OutContribution, OutGraphMaxContribution);
+}
+
+uint32 FBpCognitiveComplexityModule::GetContributionGeneration() const
+{
+	return ScoreCache.IsValid() ? ScoreCache->GetContentGeneration() : 0;
+}
+
+TOptional<FCognitiveComplexityScore> FBpCognitiveComplexityModule::GetScoreForNode(const UEdGraphNode& Node) const
+{
+	if (!ScoreCache.IsValid())
 	{
 		return {};
 	}
 
-	const FCognitiveComplexityCalculator Calculator(*Settings);
-	return Calculator.Calculate(Node);
+	return ScoreCache->GetScore(Node);
 }
 
 void FBpCognitiveComplexityModule::InvalidateBlueprint(UBlueprint* Blueprint)
 {
-	if (Blueprint == nullptr)
+	if (Blueprint == nullptr || !ScoreCache.IsValid())
 	{
 		return;
 	}
 
-	// Collect all node GUIDs that belong to this Blueprint
-	TSet<FGuid> BlueprintNodeGuids;
-	
-	auto CollectNodeGuids = [&BlueprintNodeGuids](UEdGraph* Graph)
-	{
-		if (Graph == nullptr)
-		{
-			return;
-		}
+	ScoreCache->InvalidateBlueprint(Blueprint);
+}
 
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (Node != nullptr)
-			{
-				BlueprintNodeGuids.Add(Node->NodeGuid);
-			}
-		}
-	};
+void FBpCognitiveComplexityModule::BindEditorEvents()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	PostEngineInitHandle.Reset();
 
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	if (GEditor == nullptr || CompileHandle.IsValid())
 	{
-		CollectNodeGuids(Graph);
+		return;
 	}
 
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	PreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FBpCognitiveComplexityModule::HandleBlueprintPreCompile);
+	CompileHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FBpCognitiveComplexityModule::HandleBlueprintsCompiled);
+
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
 	{
-		CollectNodeGuids(Graph);
+		AssetClosedHandle = AssetEditorSubsystem->OnAssetClosedInEditor().AddRaw(this, &FBpCognitiveComplexityModule::HandleAssetClosedInEditor);
 	}
+}
 
-	// Remove cached scores for nodes in this Blueprint
-	for (auto It = CachedScores.CreateIterator(); It; ++It)
+void FBpCognitiveComplexityModule::HandleAssetClosedInEditor(UObject* Asset, IAssetEditorInstance* Instance)
+{
+	// Closed Blueprints are no longer painted, so their scores would only take up memory.
+	if (const UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
 	{
-		if (BlueprintNodeGuids.Contains(It.Key()))
+		if (ScoreCache.IsValid())
 		{
-			It.RemoveCurrent();
+			ScoreCache->DropBlueprint(Blueprint);
 		}
 	}
 }
 
-void FBpCognitiveComplexityModule::HandleBlueprintCompiled(UBlueprint* Blueprint)
+void FBpCognitiveComplexityModule::HandleBlueprintPreCompile(UBlueprint* Blueprint)
 {
-	if (Blueprint == nullptr)
+	if (Blueprint != nullptr)
 	{
-		return;
+		CompilingBlueprints.AddUnique(Blueprint);
 	}
+}
 
-	InvalidateBlueprint(Blueprint);
+void FBpCognitiveComplexityModule::HandleBlueprintsCompiled()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBpCognitiveComplexityModule::HandleBlueprintsCompiled);
 
-	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
-	if (Settings == nullptr)
+	const TArray<TWeakObjectPtr<UBlueprint>> Compiled = MoveTemp(CompilingBlueprints);
+	for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : Compiled)
 	{
-		return;
+		HandleBlueprintCompiled(WeakBlueprint.Get());
 	}
+}
 
-	const FCognitiveComplexityCalculator Calculator(*Settings);
-
-	auto ScoreGraph = [this, &Calculator](UEdGraph* Graph)
+void FBpCognitiveComplexityModule::HandleBlueprintCompiled(UBlueprint* Blueprint)
+{
+	if (Blueprint == nullptr || !ScoreCache.IsValid())
 	{
-		if (Graph == nullptr)
-		{
-			return;
-		}
+		return;
+	}
 
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (Node == nullptr)
-			{
-				continue;
-			}
+	// Only bumps generations; the graphs are captured a few per frame from the score cache's ticker
+	// and scored on the task graph, so the compile itself pays for no traversal.
+	InvalidateBlueprint(Blueprint);
+	ScoreCache->QueueBlueprintScores(Blueprint);
+}
 
-			if (Node->IsA<UK2Node_Event>() || Node->IsA<UK2Node_FunctionEntry>())
-			{
-				const FCognitiveComplexityScore Score = Calculator.Calculate(*Node);
-				CachedScores.Add(Node->NodeGuid, Score);
-			}
-		}
-	};
+void FBpCognitiveComplexityModule::HandleSettingsChanged()
+{
+	++SettingsGeneration;
 
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
-	{
-		ScoreGraph(Graph);
-	}
+	// Macro library lists may have changed, so macro classifications have to be resolved again.
+	FCognitiveComplexityNodeClassifier::ResetMacroTable();
 
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	if (ScoreCache.IsValid())
 	{
-		ScoreGraph(Graph);
+		ScoreCache->InvalidateAll();
 	}
 }
 
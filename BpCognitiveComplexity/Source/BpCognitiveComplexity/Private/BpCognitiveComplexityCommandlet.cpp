@@ -0,0 +1,363 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "BpCognitiveComplexityCommandlet.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BpCognitiveComplexity.h"
+#include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityTypes.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Misc/Parse.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace BpCognitiveComplexityCommandlet
+{
+	static constexpr int32 ExitSuccess = 0;
+	static constexpr int32 ExitThresholdExceeded = 1;
+	static constexpr int32 ExitError = 2;
+
+	enum class EFormat : uint8
+	{
+		Csv,
+		Json,
+	};
+
+	using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	/** Writes UTF-8 lines to the output file, or to the log when no file was given (CSV only). */
+	class FOutput
+	{
+	public:
+		explicit FOutput(FArchive* InFile)
+			: File(InFile)
+		{
+		}
+
+		void WriteLine(const FString& Line)
+		{
+			if (File == nullptr)
+			{
+				UE_LOG(LogBpCognitiveComplexity, Display, TEXT("%s"), *Line);
+				return;
+			}
+
+			FTCHARToUTF8 Utf8(*Line);
+			File->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+			File->Serialize(const_cast<ANSICHAR*>("\n"), 1);
+		}
+
+		/** Pushes everything written so far to disk so partial results survive a crash on a later batch. */
+		void Flush()
+		{
+			if (File != nullptr)
+			{
+				File->Flush();
+			}
+		}
+
+	private:
+		FArchive* File = nullptr;
+	};
+
+	static FString EscapeCsv(const FString& Value)
+	{
+		if (!Value.Contains(TEXT(",")) && !Value.Contains(TEXT("\"")) && !Value.Contains(TEXT("\n")))
+		{
+			return Value;
+		}
+		return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+	}
+
+	static void WriteCsvResult(FOutput& Output, const FCognitiveComplexityBlueprintResult& Result)
+	{
+		for (const FCognitiveComplexityEntryResult& Entry : Result.Entries)
+		{
+			const FCognitiveComplexityMetrics& Metrics = Entry.Metrics;
+			Output.WriteLine(FString::Printf(TEXT("%s,%s,%s,%s,%.3f,%.3f,%d,%d,%d,%d,%d"),
+				*EscapeCsv(Result.PackageName.ToString()), *EscapeCsv(Result.BlueprintName), *EscapeCsv(Entry.EntryDisplayName),
+				*Entry.NodeGuid.ToString(), Entry.Score.RawScore, Entry.Score.Percent,
+				Metrics.Cyclomatic, Metrics.NodeCount, Metrics.MaxNesting, Metrics.MaxFanOut, Metrics.LatentCount));
+		}
+	}
+
+	static FString MakeJsonResult(const FCognitiveComplexityBlueprintResult& Result)
+	{
+		FString Json;
+		const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Json);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("package"), Result.PackageName.ToString());
+		Writer->WriteValue(TEXT("blueprint"), Result.BlueprintName);
+		Writer->WriteArrayStart(TEXT("entries"));
+		for (const FCognitiveComplexityEntryResult& Entry : Result.Entries)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("entry"), Entry.EntryDisplayName);
+			Writer->WriteValue(TEXT("nodeGuid"), Entry.NodeGuid.ToString());
+			Writer->WriteValue(TEXT("rawScore"), Entry.Score.RawScore);
+			Writer->WriteValue(TEXT("percent"), Entry.Score.Percent);
+			Writer->WriteValue(TEXT("cyclomatic"), Entry.Metrics.Cyclomatic);
+			Writer->WriteValue(TEXT("nodeCount"), Entry.Metrics.NodeCount);
+			Writer->WriteValue(TEXT("maxNesting"), Entry.Metrics.MaxNesting);
+			Writer->WriteValue(TEXT("maxFanOut"), Entry.Metrics.MaxFanOut);
+			Writer->WriteValue(TEXT("latentCount"), Entry.Metrics.LatentCount);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return Json;
+	}
+
+	static FString MakeJsonSummary(int32 NumBlueprints, int32 NumEntries, int32 NumFailed, int32 NumViolations, TOptional<float> Threshold)
+	{
+		FString Json;
+		const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Json);
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("blueprints"), NumBlueprints);
+		Writer->WriteValue(TEXT("entries"), NumEntries);
+		Writer->WriteValue(TEXT("failedToLoad"), NumFailed);
+		if (Threshold.IsSet())
+		{
+			Writer->WriteValue(TEXT("threshold"), Threshold.GetValue());
+			Writer->WriteValue(TEXT("violations"), NumViolations);
+		}
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return Json;
+	}
+
+	/**
+	 * Lets the next garbage collection reclaim packages this run loaded. The commandlet runs as the
+	 * editor, where collection keeps every RF_Standalone object and loaded assets are standalone.
+	 */
+	static void ReleasePackages(TArray<TWeakObjectPtr<UPackage>>& Packages)
+	{
+		for (const TWeakObjectPtr<UPackage>& WeakPackage : Packages)
+		{
+			if (UPackage* Package = WeakPackage.Get())
+			{
+				ForEachObjectWithPackage(Package, [](UObject* Object)
+				{
+					Object->ClearFlags(RF_Standalone);
+					return true;
+				});
+			}
+		}
+
+		Packages.Reset();
+	}
+}
+
+UBpCognitiveComplexityCommandlet::UBpCognitiveComplexityCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UBpCognitiveComplexityCommandlet::Main(const FString& Params)
+{
+	using namespace BpCognitiveComplexityCommandlet;
+
+	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+	if (Settings == nullptr)
+	{
+		return ExitError;
+	}
+
+	// Arguments.
+	FString PathList = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), PathList, /*bShouldStopOnSeparator*/false);
+
+	TArray<FString> Paths;
+	PathList.ParseIntoArray(Paths, TEXT(","), /*InCullEmpty*/true);
+
+	FString FormatString = TEXT("csv");
+	FParse::Value(*Params, TEXT("Format="), FormatString);
+
+	EFormat Format = EFormat::Csv;
+	if (FormatString.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+	{
+		Format = EFormat::Json;
+	}
+	else if (!FormatString.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogBpCognitiveComplexity, Error, TEXT("Unknown -Format=%s, expected csv or json."), *FormatString);
+		return ExitError;
+	}
+
+	TOptional<float> Threshold;
+	float ThresholdValue = 0.0f;
+	if (FParse::Value(*Params, TEXT("Threshold="), ThresholdValue))
+	{
+		Threshold = ThresholdValue;
+	}
+
+	int32 BatchSize = Settings->ScanBatchSize;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	FString OutputPath;
+	TUniquePtr<FArchive> OutputFile;
+	if (FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		OutputFile.Reset(IFileManager::Get().CreateFileWriter(*OutputPath));
+		if (!OutputFile.IsValid())
+		{
+			UE_LOG(LogBpCognitiveComplexity, Error, TEXT("Cannot open '%s' for writing."), *OutputPath);
+			return ExitError;
+		}
+	}
+	else if (Format == EFormat::Json)
+	{
+		// Log lines carry a category and verbosity prefix and interleave with other output, so they cannot be parsed as JSON.
+		UE_LOG(LogBpCognitiveComplexity, Error, TEXT("-Format=json requires -Output=File."));
+		return ExitError;
+	}
+
+	// Gather assets. The registry is not populated up front in a commandlet, so scan the requested paths first.
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.ScanPathsSynchronous(Paths, /*bForceRescan*/false);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Scanning %d Blueprints under %s in batches of %d."), Assets.Num(), *PathList, BatchSize);
+
+	FOutput Output(OutputFile.Get());
+	if (Format == EFormat::Csv)
+	{
+		Output.WriteLine(TEXT("Package,Blueprint,Entry,NodeGuid,RawScore,Percent,Cyclomatic,NodeCount,MaxNesting,MaxFanOut,LatentCount"));
+	}
+	else
+	{
+		Output.WriteLine(TEXT("{\"results\":["));
+	}
+
+	// Callees (parent-class functions, macro libraries) are scored once for the whole run.
+	FCognitiveComplexityCallGraph CallGraph;
+	FCognitiveComplexityCalculator Calculator(*Settings);
+	Calculator.SetCallGraph(&CallGraph);
+
+	int32 NumBlueprints = 0;
+	int32 NumEntries = 0;
+	int32 NumFailed = 0;
+	int32 NumViolations = 0;
+	TArray<TWeakObjectPtr<UPackage>> BatchPackages;
+
+	for (int32 BatchStart = 0; BatchStart < Assets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, Assets.Num());
+
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			const FAssetData& AssetData = Assets[AssetIndex];
+
+			// Packages that were resident before this run are not ours to release.
+			const FString PackageName = AssetData.PackageName.ToString();
+			const bool bWasLoaded = FindPackage(nullptr, *PackageName) != nullptr;
+
+			UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_NoWarn | LOAD_Quiet);
+			if (Package != nullptr && !bWasLoaded)
+			{
+				BatchPackages.Add(Package);
+			}
+
+			const UBlueprint* Blueprint = Package ? FindObject<UBlueprint>(Package, *AssetData.AssetName.ToString()) : nullptr;
+			if (Blueprint == nullptr)
+			{
+				UE_LOG(LogBpCognitiveComplexity, Warning, TEXT("Failed to load Blueprint '%s'."), *AssetData.GetObjectPathString());
+				++NumFailed;
+				continue;
+			}
+
+			FCognitiveComplexityBlueprintResult Result;
+			Result.BlueprintName = AssetData.AssetName.ToString();
+			Result.BlueprintPath = AssetData.PackagePath.ToString();
+			Result.PackageName = AssetData.PackageName;
+			Result.Entries = Calculator.ProcessBlueprint(Blueprint);
+
+			if (Format == EFormat::Csv)
+			{
+				WriteCsvResult(Output, Result);
+			}
+			else
+			{
+				Output.WriteLine((NumBlueprints > 0 ? TEXT(",") : TEXT("")) + MakeJsonResult(Result));
+			}
+
+			if (Threshold.IsSet())
+			{
+				for (const FCognitiveComplexityEntryResult& Entry : Result.Entries)
+				{
+					if (Entry.Score.Percent >= Threshold.GetValue())
+					{
+						UE_LOG(LogBpCognitiveComplexity, Warning, TEXT("%s: '%s' is at %.0f%% (threshold %.0f%%)."),
+							*Result.PackageName.ToString(), *Entry.EntryDisplayName, Entry.Score.Percent, Threshold.GetValue());
+						++NumViolations;
+					}
+				}
+			}
+
+			++NumBlueprints;
+			NumEntries += Result.Entries.Num();
+		}
+
+		Output.Flush();
+
+		// Nothing from this batch is referenced any more; reclaim it before loading the next one.
+		ReleasePackages(BatchPackages);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Scored %d / %d Blueprints."), BatchEnd, Assets.Num());
+	}
+
+	if (Format == EFormat::Json)
+	{
+		Output.WriteLine(TEXT("],\"summary\":") + MakeJsonSummary(NumBlueprints, NumEntries, NumFailed, NumViolations, Threshold) + TEXT("}"));
+	}
+
+	if (OutputFile.IsValid() && !OutputFile->Close())
+	{
+		UE_LOG(LogBpCognitiveComplexity, Error, TEXT("Failed to write '%s'."), *OutputPath);
+		return ExitError;
+	}
+
+	UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Scanned %d Blueprints (%d entries), %d failed to load."), NumBlueprints, NumEntries, NumFailed);
+
+	if (NumViolations > 0)
+	{
+		UE_LOG(LogBpCognitiveComplexity, Error, TEXT("%d entries reach the %.0f%% complexity threshold."), NumViolations, Threshold.GetValue());
+		return ExitThresholdExceeded;
+	}
+
+	return ExitSuccess;
+}
@@ -0,0 +1,30 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BpCognitiveComplexityCommandlet.generated.h"
+
+/**
+ * Headless complexity scan for build agents.
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=BpCognitiveComplexity
+ *       [-Path=/Game/A,/Game/B] [-Format=csv|json] [-Output=File] [-Threshold=Percent] [-BatchSize=N]
+ *
+ * Blueprints under the given package paths are loaded and scored in batches. After each batch
+ * the packages it loaded lose RF_Standalone and garbage is collected, so memory stays bounded
+ * regardless of project size. The batch size defaults to the ScanBatchSize setting. Results are
+ * streamed to the output file (or, for CSV only, the log) as each batch completes. Returns 1 if any entry
+ * reaches the threshold, 2 on bad arguments or I/O errors, and 0 otherwise.
+ */
+UCLASS()
+class UBpCognitiveComplexityCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBpCognitiveComplexityCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -1,12 +1,113 @@
 #include "BpCognitiveComplexitySettings.h"
 
+#include "Engine/Blueprint.h"
 #include "Internationalization/Text.h"
+#include "Misc/Crc.h"
 
 const UBpCognitiveComplexitySettings* UBpCognitiveComplexitySettings::Get()
 {
 	return GetDefault<UBpCognitiveComplexitySettings>();
 }
 
+namespace BpCognitiveComplexitySettings
+{
+	/**
+	 * Hashed in place of bMemoizedScoring when it is set. Bumped whenever memoized scores change
+	 * meaning, so results persisted under the old semantics are rescored; other modes keep theirs.
+	 */
+	static constexpr int32 MemoizedScoringRevision = 2;
+
+	/** Same for bScoreDataFlow; bumped when pure math-library calls started counting as math. */
+	static constexpr int32 DataFlowScoringRevision = 2;
+
+	static uint32 HashLibraries(uint32 Hash, std::initializer_list<const TArray<TSoftObjectPtr<UBlueprint>>*> LibraryLists)
+	{
+		// Library paths are hashed as strings; FName hashes are not stable between sessions.
+		for (const TArray<TSoftObjectPtr<UBlueprint>>* Libraries : LibraryLists)
+		{
+			const int32 NumLibraries = Libraries->Num();
+			Hash = FCrc::MemCrc32(&NumLibraries, sizeof(NumLibraries), Hash);
+
+			for (const TSoftObjectPtr<UBlueprint>& Library : *Libraries)
+			{
+				Hash = FCrc::StrCrc32(*Library.ToString(), Hash);
+			}
+		}
+		return Hash;
+	}
+}
+
+uint32 UBpCognitiveComplexitySettings::GetScoringHash() const
+{
+	using namespace BpCognitiveComplexitySettings;
+
+	const int32 ScoringValues[] =
+	{
+		BaseEntryWeight, BranchWeight, SelectWeight, LoopWeight, LatentWeight,
+		FunctionCallWeight, MathNodeWeight, NestingPenalty, PercentScale,
+		bMemoizedScoring ? MemoizedScoringRevision : 0, bWeightCallsByCallee ? 1 : 0,
+		bScoreDataFlow ? DataFlowScoringRevision : 0, DataFlowMathWeight, DataFlowCallWeight,
+	};
+
+	const uint32 Hash = FCrc::MemCrc32(ScoringValues, sizeof(ScoringValues));
+	return HashLibraries(Hash, { &LoopMacroLibraries, &BranchMacroLibraries, &LatentMacroLibraries });
+}
+
+uint32 UBpCognitiveComplexitySettings::GetFeatureHash() const
+{
+	using namespace BpCognitiveComplexitySettings;
+
+	const int32 FeatureValues[] =
+	{
+		bMemoizedScoring ? MemoizedScoringRevision : 0, bWeightCallsByCallee ? 1 : 0, bScoreDataFlow ? DataFlowScoringRevision : 0,
+	};
+
+	uint32 Hash = FCrc::MemCrc32(FeatureValues, sizeof(FeatureValues));
+
+	// Callee scores are baked into the features with the weights they were computed under.
+	if (bWeightCallsByCallee)
+	{
+		const FCognitiveComplexityWeights Weights = GetWeights();
+		Hash = FCrc::MemCrc32(&Weights, sizeof(Weights), Hash);
+	}
+
+	return HashLibraries(Hash, { &LoopMacroLibraries, &BranchMacroLibraries, &LatentMacroLibraries });
+}
+
+FCognitiveComplexityWeights UBpCognitiveComplexitySettings::GetWeights() const
+{
+	FCognitiveComplexityWeights Weights;
+
+	// Indexed by the bit position of each ECognitiveComplexityNodeCategory flag.
+	Weights.Categories[0] = static_cast<float>(BaseEntryWeight);
+	Weights.Categories[1] = static_cast<float>(BranchWeight);
+	Weights.Categories[2] = static_cast<float>(SelectWeight);
+	Weights.Categories[3] = static_cast<float>(LoopWeight);
+	Weights.Categories[4] = static_cast<float>(LatentWeight);
+	Weights.Categories[5] = static_cast<float>(FunctionCallWeight);
+	Weights.Categories[6] = static_cast<float>(MathNodeWeight);
+	Weights.NestingPenalty = static_cast<float>(NestingPenalty);
+	Weights.DataFlowMath = static_cast<float>(DataFlowMathWeight);
+	Weights.DataFlowCall = static_cast<float>(DataFlowCallWeight);
+	Weights.PercentScale = static_cast<float>(PercentScale);
+	return Weights;
+}
+
+void UBpCognitiveComplexitySettings::SetWeights(const FCognitiveComplexityWeights& Weights)
+{
+	BaseEntryWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[0]));
+	BranchWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[1]));
+	SelectWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[2]));
+	LoopWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[3]));
+	LatentWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[4]));
+	FunctionCallWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[5]));
+	MathNodeWeight = FMath::Max(0, FMath::RoundToInt(Weights.Categories[6]));
+	NestingPenalty = FMath::Max(0, FMath::RoundToInt(Weights.NestingPenalty));
+	DataFlowMathWeight = FMath::Max(0, FMath::RoundToInt(Weights.DataFlowMath));
+	DataFlowCallWeight = FMath::Max(0, FMath::RoundToInt(Weights.DataFlowCall));
+	PercentScale = FMath::Max(1, FMath::RoundToInt(Weights.PercentScale));
+}
+
 #if WITH_EDITOR
 FText UBpCognitiveComplexitySettings::GetSectionText() const
 {
@@ -22,4 +123,16 @@ FName UBpCognitiveComplexitySettings::GetCategoryName() const
 {
 	return "Plugins";
 }
+
+void UBpCognitiveComplexitySettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	OnSettingsChanged().Broadcast();
+}
+
+UBpCognitiveComplexitySettings::FOnSettingsChanged& UBpCognitiveComplexitySettings::OnSettingsChanged()
+{
+	static FOnSettingsChanged Delegate;
+	return Delegate;
+}
 #endif
@@ -0,0 +1,150 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityAssetTags.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityCalculator.h"
+#include "Engine/Blueprint.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
+FDelegateHandle FCognitiveComplexityAssetTags::TagsHandle;
+
+namespace CognitiveComplexityAssetTags
+{
+	static const FName MaxPercentTag(TEXT("CognitiveComplexityMax"));
+	static const FName SumRawScoreTag(TEXT("CognitiveComplexitySum"));
+	static const FName NumEntriesTag(TEXT("CognitiveComplexityEntries"));
+	static const FName TopEntriesTag(TEXT("CognitiveComplexityTop"));
+	static const FName SettingsHashTag(TEXT("CognitiveComplexitySettingsHash"));
+
+	static const TCHAR* FieldSeparator = TEXT("|");
+	static const TCHAR* EntrySeparator = TEXT(";");
+
+	/** Top entries as "Guid|RawScore|Percent|Name;..." with the separators stripped from names. */
+	static FString EncodeTopEntries(TArray<FCognitiveComplexityEntryResult> Entries)
+	{
+		Entries.Sort([](const FCognitiveComplexityEntryResult& A, const FCognitiveComplexityEntryResult& B)
+		{
+			return A.Score.Percent > B.Score.Percent;
+		});
+
+		TArray<FString> Encoded;
+		for (int32 Index = 0; Index < FMath::Min(Entries.Num(), FCognitiveComplexityAssetTags::MaxTopEntries); ++Index)
+		{
+			const FCognitiveComplexityEntryResult& Entry = Entries[Index];
+			const FString Name = Entry.EntryDisplayName.Replace(FieldSeparator, TEXT("_")).Replace(EntrySeparator, TEXT("_"));
+
+			Encoded.Add(FString::Join(TArray<FString>{
+				Entry.NodeGuid.ToString(),
+				FString::SanitizeFloat(Entry.Score.RawScore),
+				FString::SanitizeFloat(Entry.Score.Percent),
+				Name }, FieldSeparator));
+		}
+
+		return FString::Join(Encoded, EntrySeparator);
+	}
+
+	static bool DecodeTopEntries(const FString& Value, TArray<FCognitiveComplexityEntryResult>& OutEntries)
+	{
+		TArray<FString> Encoded;
+		Value.ParseIntoArray(Encoded, EntrySeparator, /*InCullEmpty*/true);
+
+		for (const FString& EncodedEntry : Encoded)
+		{
+			TArray<FString> Fields;
+			EncodedEntry.ParseIntoArray(Fields, FieldSeparator, /*InCullEmpty*/false);
+
+			FCognitiveComplexityEntryResult Entry;
+			if (Fields.Num() != 4 || !FGuid::Parse(Fields[0], Entry.NodeGuid))
+			{
+				return false;
+			}
+
+			Entry.Score.RawScore = FCString::Atof(*Fields[1]);
+			Entry.Score.Percent = FCString::Atof(*Fields[2]);
+			Entry.EntryDisplayName = Fields[3];
+			OutEntries.Add(MoveTemp(Entry));
+		}
+
+		return true;
+	}
+}
+
+void FCognitiveComplexityAssetTags::Register()
+{
+	TagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&FCognitiveComplexityAssetTags::HandleGetExtraObjectTags);
+}
+
+void FCognitiveComplexityAssetTags::Unregister()
+{
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(TagsHandle);
+	TagsHandle.Reset();
+}
+
+void FCognitiveComplexityAssetTags::HandleGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	using namespace CognitiveComplexityAssetTags;
+
+	// The hook also runs for in-memory registry updates and content browser queries, which must
+	// not pay for scoring every Blueprint they touch.
+	if (!Context.IsSaving())
+	{
+		return;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Context.GetObject());
+	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+	if (Blueprint == nullptr || Settings == nullptr || Settings->bWeightCallsByCallee || Blueprint->HasAnyFlags(RF_ClassDefaultObject | RF_Transient))
+	{
+		return;
+	}
+
+	const FCognitiveComplexityCalculator Calculator(*Settings);
+	const TArray<FCognitiveComplexityEntryResult> Entries = Calculator.ProcessBlueprint(Blueprint);
+
+	float MaxPercent = 0.0f;
+	float SumRawScore = 0.0f;
+	for (const FCognitiveComplexityEntryResult& Entry : Entries)
+	{
+		MaxPercent = FMath::Max(MaxPercent, Entry.Score.Percent);
+		SumRawScore += Entry.Score.RawScore;
+	}
+
+	using FTag = UObject::FAssetRegistryTag;
+	Context.AddTag(FTag(MaxPercentTag, FString::SanitizeFloat(MaxPercent), FTag::TT_Numerical));
+	Context.AddTag(FTag(SumRawScoreTag, FString::SanitizeFloat(SumRawScore), FTag::TT_Numerical));
+	Context.AddTag(FTag(NumEntriesTag, FString::FromInt(Entries.Num()), FTag::TT_Numerical));
+	Context.AddTag(FTag(TopEntriesTag, EncodeTopEntries(Entries), FTag::TT_Hidden));
+	Context.AddTag(FTag(SettingsHashTag, LexToString(Settings->GetScoringHash()), FTag::TT_Hidden));
+}
+
+bool FCognitiveComplexityAssetTags::ReadResult(const FAssetData& AssetData, const UBpCognitiveComplexitySettings& Settings, FCognitiveComplexityBlueprintResult& OutResult)
+{
+	using namespace CognitiveComplexityAssetTags;
+
+	// Tags saved by older versions under callee weighting may describe callees that changed since.
+	if (Settings.bWeightCallsByCallee)
+	{
+		return false;
+	}
+
+	FString HashValue;
+	if (!AssetData.GetTagValue(SettingsHashTag, HashValue) || HashValue != LexToString(Settings.GetScoringHash()))
+	{
+		return false;
+	}
+
+	FString TopEntriesValue;
+	TArray<FCognitiveComplexityEntryResult> Entries;
+	if (!AssetData.GetTagValue(TopEntriesTag, TopEntriesValue) || !DecodeTopEntries(TopEntriesValue, Entries))
+	{
+		return false;
+	}
+
+	OutResult.BlueprintName = AssetData.AssetName.ToString();
+	OutResult.BlueprintPath = AssetData.PackagePath.ToString();
+	OutResult.PackageName = AssetData.PackageName;
+	OutResult.Entries = MoveTemp(Entries);
+	return true;
+}
@@ -0,0 +1,44 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityTypes.h"
+
+struct FAssetData;
+class FAssetRegistryTagsContext;
+class UBpCognitiveComplexitySettings;
+
+/**
+ * Complexity summary stored as asset registry tags on every Blueprint.
+ *
+ * The tags are produced from the asset registry tag hook when a Blueprint is saved, and only
+ * then, so the registry knows the max and summed score plus the top entries of every saved
+ * Blueprint without the package having to be loaded again. Other tag queries on loaded
+ * Blueprints score nothing. The settings scoring hash is stored alongside and tags written
+ * with different weights are ignored.
+ *
+ * Scores weighted by callee also depend on other packages, which the tags cannot track, so no
+ * tags are written or read while calls are weighted by their callee.
+ */
+class FCognitiveComplexityAssetTags
+{
+public:
+	/** Entries kept per Blueprint in the top-entries tag. */
+	static constexpr int32 MaxTopEntries = 8;
+
+	static void Register();
+	static void Unregister();
+
+	/**
+	 * Builds a result from the tags of an asset, holding only its top entries.
+	 * Returns false if the asset has no tags, they were written with other settings, or calls are
+	 * weighted by their callee.
+	 */
+	static bool ReadResult(const FAssetData& AssetData, const UBpCognitiveComplexitySettings& Settings, FCognitiveComplexityBlueprintResult& OutResult);
+
+private:
+	static void HandleGetExtraObjectTags(FAssetRegistryTagsContext Context);
+
+	static FDelegateHandle TagsHandle;
+};
@@ -0,0 +1,89 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityBadgeLayout.h"
+
+#include "BpCognitiveComplexity.h"
+#include "CognitiveComplexityStats.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+
+DEFINE_STAT(STAT_BpCognitiveComplexity_BadgeLayoutRebuilds);
+DEFINE_STAT(STAT_BpCognitiveComplexity_HeatLayoutRebuilds);
+
+FCognitiveComplexityBadgeLayout FCognitiveComplexityBadgeLayout::Build(const FBpCognitiveComplexityModule& Module, const UBpCognitiveComplexitySettings& Settings, float Percent, const FSlateFontInfo& Font)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityBadgeLayout::Build);
+
+	FCognitiveComplexityBadgeLayout Layout;
+
+	const FString Label = Module.GetComplexityLabelForPercent(Percent, &Settings);
+	// Prefix with a small diamond-like glyph to subtly echo IDE complexity indicators.
+	Layout.Text = FString::Printf(TEXT("◆ %s (%.0f%%)"), *Label, Percent);
+	Layout.TextSize = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->Measure(Layout.Text, Font);
+	Layout.Color = ComplexityColorForPercent(Settings, Percent);
+
+	return Layout;
+}
+
+const FCognitiveComplexityBadgeLayout& FCognitiveComplexityBadgeLayoutCache::Get(const FBpCognitiveComplexityModule& Module, const UBpCognitiveComplexitySettings& Settings, uint32 SettingsGeneration, float Percent, const FSlateFontInfo& Font)
+{
+	if (LayoutSettingsGeneration != SettingsGeneration || LayoutPercent != Percent || !LayoutFont.IsIdenticalTo(Font))
+	{
+		Layout = FCognitiveComplexityBadgeLayout::Build(Module, Settings, Percent, Font);
+		LayoutFont = Font;
+		LayoutPercent = Percent;
+		LayoutSettingsGeneration = SettingsGeneration;
+
+		INC_DWORD_STAT(STAT_BpCognitiveComplexity_BadgeLayoutRebuilds);
+	}
+
+	return Layout;
+}
+
+FCognitiveComplexityHeatLayout FCognitiveComplexityHeatLayout::Build(const FCognitiveComplexityNodeContribution& Contribution, float GraphMaxContribution, const FSlateFontInfo& Font)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityHeatLayout::Build);
+
+	FCognitiveComplexityHeatLayout Layout;
+
+	const float Total = Contribution.GetTotal();
+	if (Total <= 0.0f)
+	{
+		return Layout;
+	}
+
+	// Relative to the hottest node of the graph, so every graph uses the full yellow -> red range.
+	const float Heat = GraphMaxContribution > 0.0f ? FMath::Clamp(Total / GraphMaxContribution, 0.0f, 1.0f) : 1.0f;
+	const FLinearColor Color = FMath::Lerp(FLinearColor(0.95f, 0.80f, 0.10f), FLinearColor(0.85f, 0.05f, 0.05f), Heat);
+
+	Layout.bVisible = true;
+	Layout.Text = Contribution.NestingPenalty > 0.0f
+		? FString::Printf(TEXT("+%g (%g nesting)"), Total, Contribution.NestingPenalty)
+		: FString::Printf(TEXT("+%g"), Total);
+	Layout.TextSize = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->Measure(Layout.Text, Font);
+	Layout.Tint = Color.CopyWithNewOpacity(0.10f + 0.30f * Heat);
+	Layout.TextColor = Color.CopyWithNewOpacity(0.95f);
+
+	return Layout;
+}
+
+const FCognitiveComplexityHeatLayout& FCognitiveComplexityHeatLayoutCache::Get(const FBpCognitiveComplexityModule& Module, const UEdGraphNode& Node, const FSlateFontInfo& Font)
+{
+	const uint32 ContentGeneration = Module.GetContributionGeneration();
+	if (LayoutContentGeneration != ContentGeneration || !LayoutFont.IsIdenticalTo(Font))
+	{
+		FCognitiveComplexityNodeContribution Contribution;
+		float GraphMaxContribution = 0.0f;
+
+		// Looking up may rescore the graph's entries and move the generation, so read it again afterwards.
+		Layout = Module.GetNodeContribution(Node, Contribution, GraphMaxContribution)
+			? FCognitiveComplexityHeatLayout::Build(Contribution, GraphMaxContribution, Font)
+			: FCognitiveComplexityHeatLayout();
+		LayoutFont = Font;
+		LayoutContentGeneration = Module.GetContributionGeneration();
+
+		INC_DWORD_STAT(STAT_BpCognitiveComplexity_HeatLayoutRebuilds);
+	}
+
+	return Layout;
+}
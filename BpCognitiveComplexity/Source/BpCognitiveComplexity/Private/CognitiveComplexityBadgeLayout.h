@@ -0,0 +1,76 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityTypes.h"
+#include "Fonts/SlateFontInfo.h"
+
+class FBpCognitiveComplexityModule;
+class UEdGraphNode;
+class UBpCognitiveComplexitySettings;
+
+FLinearColor ComplexityColorForPercent(const UBpCognitiveComplexitySettings& Settings, float Percent);
+
+/** Everything needed to draw an entry node badge: its text, measured size and color. */
+struct FCognitiveComplexityBadgeLayout
+{
+	FString Text;
+	FVector2D TextSize = FVector2D::ZeroVector;
+	FLinearColor Color = FLinearColor::White;
+
+	/** Formats the label and measures it. Allocates and shapes text, so keep it out of per-frame paths. */
+	static FCognitiveComplexityBadgeLayout Build(const FBpCognitiveComplexityModule& Module, const UBpCognitiveComplexitySettings& Settings, float Percent, const FSlateFontInfo& Font);
+};
+
+/**
+ * Last badge layout of one node widget.
+ *
+ * Painting asks for the layout every frame, but it only changes with the score, the settings
+ * (thresholds move labels and colors) or the font, so it is rebuilt only when one of those did.
+ */
+class FCognitiveComplexityBadgeLayoutCache
+{
+public:
+	const FCognitiveComplexityBadgeLayout& Get(const FBpCognitiveComplexityModule& Module, const UBpCognitiveComplexitySettings& Settings, uint32 SettingsGeneration, float Percent, const FSlateFontInfo& Font);
+
+private:
+	FCognitiveComplexityBadgeLayout Layout;
+	FSlateFontInfo LayoutFont;
+	float LayoutPercent = 0.0f;
+
+	/** Settings generations start at 1, so 0 means nothing has been built yet. */
+	uint32 LayoutSettingsGeneration = 0;
+};
+
+/** Heatmap overlay of one non-entry node: the contribution label and the tint laid over the node. */
+struct FCognitiveComplexityHeatLayout
+{
+	bool bVisible = false;
+	FString Text;
+	FVector2D TextSize = FVector2D::ZeroVector;
+	FLinearColor Tint = FLinearColor::Transparent;
+	FLinearColor TextColor = FLinearColor::White;
+
+	/** Formats and measures the label for a contribution relative to the hottest node of its graph. */
+	static FCognitiveComplexityHeatLayout Build(const FCognitiveComplexityNodeContribution& Contribution, float GraphMaxContribution, const FSlateFontInfo& Font);
+};
+
+/**
+ * Last heatmap layout of one node widget.
+ *
+ * The contribution lookup goes through the score cache's per-graph table, so it is only repeated
+ * when the cache's content generation moved; every other frame is a single integer compare.
+ */
+class FCognitiveComplexityHeatLayoutCache
+{
+public:
+	const FCognitiveComplexityHeatLayout& Get(const FBpCognitiveComplexityModule& Module, const UEdGraphNode& Node, const FSlateFontInfo& Font);
+
+private:
+	FCognitiveComplexityHeatLayout Layout;
+	FSlateFontInfo LayoutFont;
+
+	/** Content generations start at 1, so 0 means nothing has been looked up yet. */
+	uint32 LayoutContentGeneration = 0;
+};
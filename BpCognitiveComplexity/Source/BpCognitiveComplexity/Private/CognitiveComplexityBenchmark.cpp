@@ -0,0 +1,608 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "BpCognitiveComplexity.h"
+#include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityBadgeLayout.h"
+#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityFlatGraph.h"
+#include "CognitiveComplexityNodeClassifier.h"
+#include "CognitiveComplexitySyntheticGraph.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "Styling/AppStyle.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UObjectIterator.h"
+
+/**
+ * Editor console benchmarks for the calculator. They build synthetic Blueprints, time the
+ * scoring paths and log the results to LogBpCognitiveComplexity.
+ */
+namespace CognitiveComplexityBenchmark
+{
+	static constexpr int32 NumRepetitions = 3;
+
+	static int32 ParseIntArg(const TArray<FString>& Args, int32 Index, int32 DefaultValue)
+	{
+		return Args.IsValidIndex(Index) ? FCString::Atoi(*Args[Index]) : DefaultValue;
+	}
+
+	/** Scores every entry once, spreading the entries over at most NumLanes concurrent workers. */
+	static double TimeScoring(const FCognitiveComplexityCalculator& Calculator, const TArray<const UEdGraphNode*>& EntryNodes, int32 NumLanes, double& OutTotalScore)
+	{
+		TArray<double> LaneScores;
+		LaneScores.SetNumZeroed(NumLanes);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		ParallelFor(NumLanes, [&Calculator, &EntryNodes, &LaneScores, NumLanes](int32 Lane)
+		{
+			for (int32 Index = Lane; Index < EntryNodes.Num(); Index += NumLanes)
+			{
+				LaneScores[Lane] += Calculator.Calculate(*EntryNodes[Index]).RawScore;
+			}
+		});
+
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		OutTotalScore = 0.0;
+		for (const double LaneScore : LaneScores)
+		{
+			OutTotalScore += LaneScore;
+		}
+
+		return Elapsed;
+	}
+
+	static void RunScalingBenchmark(const TArray<FString>& Args)
+	{
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		if (Settings == nullptr)
+		{
+			return;
+		}
+
+		FCognitiveComplexitySyntheticGraphParams Params;
+		Params.NumEntries = ParseIntArg(Args, 0, 256);
+		Params.NodesPerEntry = ParseIntArg(Args, 1, 2000);
+		if (Args.IsValidIndex(2) && !FCognitiveComplexitySyntheticGraph::ParseShape(Args[2], Params.Shape))
+		{
+			UE_LOG(LogBpCognitiveComplexity, Error, TEXT("Unknown synthetic shape '%s'."), *Args[2]);
+			return;
+		}
+
+		UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateBlueprint(Params);
+		const TArray<const UEdGraphNode*> EntryNodes = FCognitiveComplexitySyntheticGraph::GetEntryNodes(Blueprint);
+		const FCognitiveComplexityCalculator Calculator(*Settings);
+
+		const int32 MaxLanes = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Scaling benchmark: %d entries x %d nodes (%s), up to %d lanes."),
+			Params.NumEntries, Params.NodesPerEntry, FCognitiveComplexitySyntheticGraph::ShapeToString(Params.Shape), MaxLanes);
+
+		TArray<int32> LaneCounts;
+		for (int32 NumLanes = 1; NumLanes < MaxLanes; NumLanes *= 2)
+		{
+			LaneCounts.Add(NumLanes);
+		}
+		LaneCounts.Add(MaxLanes);
+
+		double SingleLaneSeconds = 0.0;
+		double ReferenceScore = 0.0;
+
+		for (const int32 NumLanes : LaneCounts)
+		{
+			double BestSeconds = TNumericLimits<double>::Max();
+			double TotalScore = 0.0;
+
+			for (int32 Repetition = 0; Repetition < NumRepetitions; ++Repetition)
+			{
+				BestSeconds = FMath::Min(BestSeconds, TimeScoring(Calculator, EntryNodes, NumLanes, TotalScore));
+			}
+
+			if (NumLanes == 1)
+			{
+				SingleLaneSeconds = BestSeconds;
+				ReferenceScore = TotalScore;
+			}
+
+			const double Speedup = SingleLaneSeconds / FMath::Max(BestSeconds, UE_DOUBLE_SMALL_NUMBER);
+			UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  %2d lanes: %8.2f ms  speedup %5.2fx  efficiency %5.1f%%%s"),
+				NumLanes, BestSeconds * 1000.0, Speedup, Speedup / NumLanes * 100.0,
+				TotalScore == ReferenceScore ? TEXT("") : TEXT("  SCORE MISMATCH"));
+		}
+
+		FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+	}
+
+	/** Classifies every node of the graph once with the given classifier and returns the elapsed time. */
+	template <typename ClassifyFunc>
+	static double TimeClassification(const UEdGraph* Graph, ClassifyFunc Classify, TArray<ECognitiveComplexityNodeCategory>& OutCategories)
+	{
+		OutCategories.Reset(Graph->Nodes.Num());
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			OutCategories.Add(Classify(Node));
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	static void RunClassificationBenchmark(const TArray<FString>& Args)
+	{
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		if (Settings == nullptr)
+		{
+			return;
+		}
+
+		// Many medium chains rather than one long one: the recursive walk would otherwise go 50k frames deep.
+		FCognitiveComplexitySyntheticGraphParams Params;
+		Params.Shape = ECognitiveComplexitySyntheticShape::Mixed;
+		Params.NodesPerEntry = 1000;
+		Params.NumEntries = FMath::Max(1, ParseIntArg(Args, 0, 50000) / Params.NodesPerEntry);
+
+		UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateBlueprint(Params);
+		const UEdGraph* Graph = FCognitiveComplexitySyntheticGraph::GetGraph(Blueprint);
+		if (Graph == nullptr)
+		{
+			FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+			return;
+		}
+
+		double UncachedSeconds = TNumericLimits<double>::Max();
+		double CachedSeconds = TNumericLimits<double>::Max();
+		TArray<ECognitiveComplexityNodeCategory> UncachedCategories;
+		TArray<ECognitiveComplexityNodeCategory> CachedCategories;
+
+		for (int32 Repetition = 0; Repetition < NumRepetitions; ++Repetition)
+		{
+			UncachedSeconds = FMath::Min(UncachedSeconds, TimeClassification(Graph, &FCognitiveComplexityNodeClassifier::ClassifyUncached, UncachedCategories));
+			CachedSeconds = FMath::Min(CachedSeconds, TimeClassification(Graph, &FCognitiveComplexityNodeClassifier::Classify, CachedCategories));
+		}
+
+		const FCognitiveComplexityCalculator Calculator(*Settings);
+		const TArray<const UEdGraphNode*> EntryNodes = FCognitiveComplexitySyntheticGraph::GetEntryNodes(Blueprint);
+		double TotalScore = 0.0;
+		const double ScoringSeconds = TimeScoring(Calculator, EntryNodes, 1, TotalScore);
+
+		const int32 NumNodes = Graph->Nodes.Num();
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Classification benchmark: %d nodes (%d entries x %d, Mixed)."), NumNodes, Params.NumEntries, Params.NodesPerEntry);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  per-node predicates: %8.2f ms  (%6.1f ns/node)"), UncachedSeconds * 1000.0, UncachedSeconds * 1.0e9 / NumNodes);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  class table:         %8.2f ms  (%6.1f ns/node)  %5.2fx%s"), CachedSeconds * 1000.0, CachedSeconds * 1.0e9 / NumNodes,
+			UncachedSeconds / FMath::Max(CachedSeconds, UE_DOUBLE_SMALL_NUMBER), UncachedCategories == CachedCategories ? TEXT("") : TEXT("  CATEGORY MISMATCH"));
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  full Calculate:      %8.2f ms  (%6.1f ns/node)  total score %.0f"), ScoringSeconds * 1000.0, ScoringSeconds * 1.0e9 / NumNodes, TotalScore);
+
+		FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+	}
+
+	/** Scores differ only by float summation order between the two walks, so compare with a relative tolerance. */
+	static bool ScoresMatch(float A, float B)
+	{
+		return FMath::IsNearlyEqual(A, B, KINDA_SMALL_NUMBER * FMath::Max(1.0f, FMath::Abs(A)));
+	}
+
+	/**
+	 * Scores every entry of the given graphs with both the recursive walk and the flat-graph walk.
+	 * Returns the number of entries whose scores differ and logs each of them.
+	 */
+	static int32 CompareEngines(const FCognitiveComplexityCalculator& Calculator, TConstArrayView<const UEdGraph*> Graphs, const FString& Label)
+	{
+		const FCognitiveComplexityFlatGraph FlatGraph = FCognitiveComplexityFlatGraph::Build(Graphs);
+
+		// Same numbering as FCognitiveComplexityFlatGraph::Build.
+		TArray<const UEdGraphNode*> Nodes;
+		for (const UEdGraph* Graph : Graphs)
+		{
+			if (Graph == nullptr)
+			{
+				continue;
+			}
+
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (Node != nullptr)
+				{
+					Nodes.Add(Node);
+				}
+			}
+		}
+
+		int32 NumMismatches = 0;
+		for (const int32 EntryIndex : FlatGraph.EntryIndices)
+		{
+			const float RecursiveScore = Calculator.Calculate(*Nodes[EntryIndex]).RawScore;
+			const float FlatScore = Calculator.Calculate(FlatGraph, EntryIndex).RawScore;
+			if (!ScoresMatch(RecursiveScore, FlatScore))
+			{
+				UE_LOG(LogBpCognitiveComplexity, Warning, TEXT("  %s: entry '%s' scores %.3f recursively but %.3f on the flat graph."),
+					*Label, *Nodes[EntryIndex]->GetNodeTitle(ENodeTitleType::ListView).ToString(), RecursiveScore, FlatScore);
+				++NumMismatches;
+			}
+		}
+		return NumMismatches;
+	}
+
+	static void RunFlatGraphBenchmark(const TArray<FString>& Args)
+	{
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		if (Settings == nullptr)
+		{
+			return;
+		}
+
+		FCognitiveComplexitySyntheticGraphParams Params;
+		Params.NumEntries = ParseIntArg(Args, 0, 64);
+		Params.NodesPerEntry = ParseIntArg(Args, 1, 5000);
+		if (Args.IsValidIndex(2) && !FCognitiveComplexitySyntheticGraph::ParseShape(Args[2], Params.Shape))
+		{
+			UE_LOG(LogBpCognitiveComplexity, Error, TEXT("Unknown synthetic shape '%s'."), *Args[2]);
+			return;
+		}
+
+		UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateBlueprint(Params);
+		const UEdGraph* Graph = FCognitiveComplexitySyntheticGraph::GetGraph(Blueprint);
+		if (Graph == nullptr)
+		{
+			FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+			return;
+		}
+
+		const TArray<const UEdGraphNode*> EntryNodes = FCognitiveComplexitySyntheticGraph::GetEntryNodes(Blueprint);
+		const FCognitiveComplexityCalculator Calculator(*Settings);
+		const int32 NumNodes = Graph->Nodes.Num();
+
+		double RecursiveSeconds = TNumericLimits<double>::Max();
+		double BuildSeconds = TNumericLimits<double>::Max();
+		double FlatSeconds = TNumericLimits<double>::Max();
+		double RecursiveScore = 0.0;
+		double FlatScore = 0.0;
+
+		for (int32 Repetition = 0; Repetition < NumRepetitions; ++Repetition)
+		{
+			RecursiveSeconds = FMath::Min(RecursiveSeconds, TimeScoring(Calculator, EntryNodes, 1, RecursiveScore));
+
+			double StartTime = FPlatformTime::Seconds();
+			const FCognitiveComplexityFlatGraph FlatGraph = FCognitiveComplexityFlatGraph::Build(MakeArrayView(&Graph, 1));
+			BuildSeconds = FMath::Min(BuildSeconds, FPlatformTime::Seconds() - StartTime);
+
+			StartTime = FPlatformTime::Seconds();
+			FlatScore = 0.0;
+			for (const int32 EntryIndex : FlatGraph.EntryIndices)
+			{
+				FlatScore += Calculator.Calculate(FlatGraph, EntryIndex).RawScore;
+			}
+			FlatSeconds = FMath::Min(FlatSeconds, FPlatformTime::Seconds() - StartTime);
+		}
+
+		const int32 NumMismatches = CompareEngines(Calculator, MakeArrayView(&Graph, 1), TEXT("Synthetic"));
+
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Flat graph benchmark: %d entries x %d nodes (%s), %d nodes total."),
+			Params.NumEntries, Params.NodesPerEntry, FCognitiveComplexitySyntheticGraph::ShapeToString(Params.Shape), NumNodes);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  recursive walk:   %8.2f ms  (%6.1f ns/node)  total score %.0f"), RecursiveSeconds * 1000.0, RecursiveSeconds * 1.0e9 / NumNodes, RecursiveScore);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  flat build:       %8.2f ms  (%6.1f ns/node)"), BuildSeconds * 1000.0, BuildSeconds * 1.0e9 / NumNodes);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  flat walk:        %8.2f ms  (%6.1f ns/node)  total score %.0f  %5.2fx"), FlatSeconds * 1000.0, FlatSeconds * 1.0e9 / NumNodes, FlatScore,
+			RecursiveSeconds / FMath::Max(FlatSeconds, UE_DOUBLE_SMALL_NUMBER));
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  %d of %d entries differ between the engines."), NumMismatches, EntryNodes.Num());
+
+		FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+	}
+
+	static void RunFlatGraphVerification()
+	{
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		if (Settings == nullptr)
+		{
+			return;
+		}
+
+		const FCognitiveComplexityCalculator Calculator(*Settings);
+
+		int32 NumBlueprints = 0;
+		int32 NumMismatches = 0;
+
+		// Every synthetic shape first, then every Blueprint currently loaded in the editor.
+		for (const ECognitiveComplexitySyntheticShape Shape : AllSyntheticShapes)
+		{
+			FCognitiveComplexitySyntheticGraphParams Params;
+			Params.Shape = Shape;
+			Params.NumEntries = 8;
+			Params.NodesPerEntry = 500;
+
+			UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateBlueprint(Params);
+			const UEdGraph* Graph = FCognitiveComplexitySyntheticGraph::GetGraph(Blueprint);
+			NumMismatches += CompareEngines(Calculator, MakeArrayView(&Graph, 1), FCognitiveComplexitySyntheticGraph::ShapeToString(Shape));
+			FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+		}
+
+		for (TObjectIterator<UBlueprint> It; It; ++It)
+		{
+			const UBlueprint* Blueprint = *It;
+			if (Blueprint->HasAnyFlags(RF_ClassDefaultObject | RF_Transient))
+			{
+				continue;
+			}
+
+			TArray<const UEdGraph*, TInlineAllocator<16>> Graphs;
+			Graphs.Append(Blueprint->UbergraphPages);
+			Graphs.Append(Blueprint->FunctionGraphs);
+
+			NumMismatches += CompareEngines(Calculator, Graphs, Blueprint->GetPathName());
+			++NumBlueprints;
+		}
+
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Flat graph verification: %d synthetic shapes and %d loaded Blueprints, %d mismatching entries."),
+			static_cast<int32>(UE_ARRAY_COUNT(AllSyntheticShapes)), NumBlueprints, NumMismatches);
+	}
+
+	/**
+	 * Simulates the badge work of NumFrames paints of NumBadges entry nodes, once rebuilding the
+	 * layout every frame as painting used to and once through per-widget layout caches.
+	 * The live per-frame cost in the graph editor shows up under "stat BpCognitiveComplexity".
+	 */
+	static void RunBadgeLayoutBenchmark(const TArray<FString>& Args)
+	{
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		if (Settings == nullptr || !FSlateApplication::IsInitialized() || !FBpCognitiveComplexityModule::IsAvailable())
+		{
+			return;
+		}
+
+		const int32 NumBadges = FMath::Max(1, ParseIntArg(Args, 0, 500));
+		const int32 NumFrames = FMath::Max(1, ParseIntArg(Args, 1, 120));
+
+		const FBpCognitiveComplexityModule& Module = FBpCognitiveComplexityModule::Get();
+		const FSlateFontInfo Font = FAppStyle::GetFontStyle(TEXT("BlueprintEditor.Node.TitleFont"));
+
+		// Spread the badges over every label and color band.
+		TArray<float> Percents;
+		for (int32 Index = 0; Index < NumBadges; ++Index)
+		{
+			Percents.Add(static_cast<float>((Index * 37) % 200));
+		}
+
+		double TextLength = 0.0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (const float Percent : Percents)
+			{
+				TextLength += FCognitiveComplexityBadgeLayout::Build(Module, *Settings, Percent, Font).TextSize.X;
+			}
+		}
+		const double RebuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TArray<FCognitiveComplexityBadgeLayoutCache> Caches;
+		Caches.SetNum(NumBadges);
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (int32 Index = 0; Index < NumBadges; ++Index)
+			{
+				TextLength -= Caches[Index].Get(Module, *Settings, Module.GetSettingsGeneration(), Percents[Index], Font).TextSize.X;
+			}
+		}
+		const double CachedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Badge layout benchmark: %d badges x %d frames."), NumBadges, NumFrames);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  rebuild every frame: %8.3f ms/frame"), RebuildSeconds * 1000.0 / NumFrames);
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  cached layouts:      %8.3f ms/frame  %5.1fx%s"), CachedSeconds * 1000.0 / NumFrames,
+			RebuildSeconds / FMath::Max(CachedSeconds, UE_DOUBLE_SMALL_NUMBER), FMath::IsNearlyZero(TextLength, 1.0) ? TEXT("") : TEXT("  LAYOUT MISMATCH"));
+	}
+
+	using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	/** Largest chain handed to the recursive walk in the suite; bigger sizes get more entries instead. */
+	static constexpr int32 SuiteNodesPerEntry = 1000;
+
+	struct FSuiteSample
+	{
+		double Seconds = TNumericLimits<double>::Max();
+
+		/** Malloc and Realloc calls made by the whole process during the fastest run; zero when the allocator does not count them. */
+		uint64 Allocations = 0;
+	};
+
+	static uint64 GetAllocationCount()
+	{
+#if !UE_BUILD_SHIPPING
+		return static_cast<uint64>(FMalloc::TotalMallocCalls) + static_cast<uint64>(FMalloc::TotalReallocCalls);
+#else
+		return 0;
+#endif
+	}
+
+	/** Runs the work NumRuns times and keeps the fastest run together with its allocation count. */
+	static FSuiteSample TimeSuiteRun(int32 NumRuns, TFunctionRef<void()> Work)
+	{
+		FSuiteSample Best;
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			const uint64 StartAllocations = GetAllocationCount();
+			const double StartTime = FPlatformTime::Seconds();
+			Work();
+			const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+			if (Elapsed < Best.Seconds)
+			{
+				Best.Seconds = Elapsed;
+				Best.Allocations = GetAllocationCount() - StartAllocations;
+			}
+		}
+		return Best;
+	}
+
+	static void WriteSuiteSample(FCondensedJsonWriter& Writer, const TCHAR* Name, const FSuiteSample& Sample, int32 NumNodes)
+	{
+		Writer.WriteObjectStart(Name);
+		Writer.WriteValue(TEXT("seconds"), Sample.Seconds);
+		Writer.WriteValue(TEXT("nodesPerSecond"), NumNodes / FMath::Max(Sample.Seconds, UE_DOUBLE_SMALL_NUMBER));
+		Writer.WriteValue(TEXT("allocations"), static_cast<int64>(Sample.Allocations));
+		Writer.WriteObjectEnd();
+	}
+
+	static void LogSuiteSample(const TCHAR* Name, const FSuiteSample& Sample, int32 NumNodes)
+	{
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("    %-17s %10.2f ms  %8.2f Mnodes/s  %10llu allocations"),
+			Name, Sample.Seconds * 1000.0, NumNodes / FMath::Max(Sample.Seconds, UE_DOUBLE_SMALL_NUMBER) / 1.0e6, Sample.Allocations);
+	}
+
+	/**
+	 * Times Calculate, ProcessGraph and ProcessBlueprint on every synthetic shape at 100 to 1M nodes
+	 * and writes the results as JSON so runs can be diffed for regressions.
+	 */
+	static void RunBenchmarkSuite(const TArray<FString>& Args)
+	{
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		if (Settings == nullptr)
+		{
+			return;
+		}
+
+		const int32 MaxNodes = FMath::Max(100, ParseIntArg(Args, 0, 1000000));
+		const FString OutputPath = Args.IsValidIndex(1)
+			? Args[1]
+			: FPaths::ProjectSavedDir() / TEXT("BpCognitiveComplexity") / FString::Printf(TEXT("BenchmarkSuite-%s.json"), *FDateTime::Now().ToString());
+
+		const FCognitiveComplexityCalculator Calculator(*Settings);
+
+		FString Json;
+		const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Json);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("settingsHash"), static_cast<int64>(Settings->GetScoringHash()));
+		Writer->WriteValue(TEXT("workerThreads"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+		Writer->WriteArrayStart(TEXT("results"));
+
+		UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Benchmark suite: %d shapes up to %d nodes."), static_cast<int32>(UE_ARRAY_COUNT(AllSyntheticShapes)), MaxNodes);
+
+		for (const ECognitiveComplexitySyntheticShape Shape : AllSyntheticShapes)
+		{
+			for (int32 Size = 100; Size <= MaxNodes; Size *= 10)
+			{
+				FCognitiveComplexitySyntheticGraphParams Params;
+				Params.Shape = Shape;
+				Params.NodesPerEntry = FMath::Min(Size, SuiteNodesPerEntry);
+				Params.NumEntries = FMath::Max(1, Size / Params.NodesPerEntry);
+
+				UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateBlueprint(Params);
+				const UEdGraph* Graph = FCognitiveComplexitySyntheticGraph::GetGraph(Blueprint);
+				if (Graph == nullptr)
+				{
+					FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+					continue;
+				}
+
+				const TArray<const UEdGraphNode*> EntryNodes = FCognitiveComplexitySyntheticGraph::GetEntryNodes(Blueprint);
+				const int32 NumNodes = Graph->Nodes.Num();
+
+				// The largest sizes take long enough that a single run is stable.
+				const int32 NumRuns = Size >= 1000000 ? 1 : NumRepetitions;
+
+				double TotalScore = 0.0;
+				const FSuiteSample CalculateSample = TimeSuiteRun(NumRuns, [&Calculator, &EntryNodes, &TotalScore]()
+				{
+					TotalScore = 0.0;
+					for (const UEdGraphNode* EntryNode : EntryNodes)
+					{
+						TotalScore += Calculator.Calculate(*EntryNode).RawScore;
+					}
+				});
+
+				const FSuiteSample ProcessGraphSample = TimeSuiteRun(NumRuns, [&Calculator, Graph]()
+				{
+					Calculator.ProcessGraph(Graph);
+				});
+
+				const FSuiteSample ProcessBlueprintSample = TimeSuiteRun(NumRuns, [&Calculator, Blueprint]()
+				{
+					Calculator.ProcessBlueprint(Blueprint);
+				});
+
+				const TCHAR* ShapeName = FCognitiveComplexitySyntheticGraph::ShapeToString(Shape);
+				UE_LOG(LogBpCognitiveComplexity, Display, TEXT("  %s, %d nodes (%d entries x %d), total score %.0f"),
+					ShapeName, NumNodes, Params.NumEntries, Params.NodesPerEntry, TotalScore);
+				LogSuiteSample(TEXT("Calculate"), CalculateSample, NumNodes);
+				LogSuiteSample(TEXT("ProcessGraph"), ProcessGraphSample, NumNodes);
+				LogSuiteSample(TEXT("ProcessBlueprint"), ProcessBlueprintSample, NumNodes);
+
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("shape"), ShapeName);
+				Writer->WriteValue(TEXT("nodes"), NumNodes);
+				Writer->WriteValue(TEXT("entries"), Params.NumEntries);
+				Writer->WriteValue(TEXT("nodesPerEntry"), Params.NodesPerEntry);
+				Writer->WriteValue(TEXT("totalScore"), TotalScore);
+				WriteSuiteSample(*Writer, TEXT("calculate"), CalculateSample, NumNodes);
+				WriteSuiteSample(*Writer, TEXT("processGraph"), ProcessGraphSample, NumNodes);
+				WriteSuiteSample(*Writer, TEXT("processBlueprint"), ProcessBlueprintSample, NumNodes);
+				Writer->WriteObjectEnd();
+
+				// Reclaim the graph before building the next, larger one.
+				FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+				if (Size > MaxNodes / 10)
+				{
+					break;
+				}
+			}
+		}
+
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		if (FFileHelper::SaveStringToFile(Json, *OutputPath))
+		{
+			UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Benchmark suite results written to %s"), *OutputPath);
+		}
+		else
+		{
+			UE_LOG(LogBpCognitiveComplexity, Error, TEXT("Could not write benchmark suite results to %s"), *OutputPath);
+		}
+	}
+
+	static FAutoConsoleCommand ScalingBenchmarkCommand(
+		TEXT("BpCognitiveComplexity.Benchmark.Scaling"),
+		TEXT("Scores a synthetic Blueprint with 1, 2, 4 ... worker lanes and logs the speedup. Args: [NumEntries=256] [NodesPerEntry=2000] [Chain|BranchNest|Mixed|WideSequence|SwitchFanOut|CyclicLoop]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunScalingBenchmark));
+
+	static FAutoConsoleCommand ClassificationBenchmarkCommand(
+		TEXT("BpCognitiveComplexity.Benchmark.Classification"),
+		TEXT("Compares per-node predicate classification with the per-class table on a synthetic mixed graph. Args: [NumNodes=50000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunClassificationBenchmark));
+
+	static FAutoConsoleCommand FlatGraphBenchmarkCommand(
+		TEXT("BpCognitiveComplexity.Benchmark.FlatGraph"),
+		TEXT("Compares the recursive walk with building and walking the flat graph on a synthetic Blueprint. Args: [NumEntries=64] [NodesPerEntry=5000] [Chain|BranchNest|Mixed|WideSequence|SwitchFanOut|CyclicLoop]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunFlatGraphBenchmark));
+
+	static FAutoConsoleCommand BadgeLayoutBenchmarkCommand(
+		TEXT("BpCognitiveComplexity.Benchmark.BadgeLayout"),
+		TEXT("Compares rebuilding entry badge layouts every frame with the per-widget layout cache. Args: [NumBadges=500] [NumFrames=120]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBadgeLayoutBenchmark));
+
+	static FAutoConsoleCommand BenchmarkSuiteCommand(
+		TEXT("BpCognitiveComplexity.Benchmark.Suite"),
+		TEXT("Times Calculate, ProcessGraph and ProcessBlueprint on every synthetic shape from 100 nodes up by powers of ten and writes the results as JSON. Args: [MaxNodes=1000000] [OutputFile]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmarkSuite));
+
+	static FAutoConsoleCommand FlatGraphVerifyCommand(
+		TEXT("BpCognitiveComplexity.VerifyFlatGraph"),
+		TEXT("Checks that the flat-graph walk scores every entry of the synthetic shapes and all loaded Blueprints the same as the recursive walk."),
+		FConsoleCommandDelegate::CreateStatic(&RunFlatGraphVerification));
+}
@@ -1,131 +1,542 @@
 #include "CognitiveComplexityCalculator.h"
 
 #include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityFlatGraph.h"
+#include "CognitiveComplexityMetricVisitor.h"
+#include "CognitiveComplexitySnapshot.h"
+#include "CognitiveComplexityStats.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraphSchema_K2.h"
 #include "Engine/Blueprint.h"
-#include "K2Node.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_CommutativeAssociativeBinaryOperator.h"
-#include "K2Node_ExecutionSequence.h"
-#include "K2Node_IfThenElse.h"
-#include "K2Node_MathExpression.h"
-#include "K2Node_Select.h"
-#include "K2Node_SwitchEnum.h"
-#include "K2Node_SwitchInteger.h"
-#include "K2Node_SwitchName.h"
-#include "K2Node_SwitchString.h"
-#include "K2Node_Timeline.h"
-#include "K2Node_BaseAsyncTask.h"
-#include "K2Node_Event.h"
-#include "K2Node_FunctionEntry.h"
-
-namespace CognitiveComplexity
+#include "Async/ParallelFor.h"
+
+DEFINE_STAT(STAT_BpCognitiveComplexity_EntriesScored);
+DEFINE_STAT(STAT_BpCognitiveComplexity_NodesVisited);
+DEFINE_STAT(STAT_BpCognitiveComplexity_ProcessBlueprint);
+DEFINE_STAT(STAT_BpCognitiveComplexity_ScoreEntries);
+
+struct FCognitiveComplexityCalculator::FMemoContext
+{
+	explicit FMemoContext(const FCognitiveComplexityFlatGraph& InGraph)
+		: Graph(InGraph)
+		, Condensed(FCognitiveComplexityCondensedGraph::Build(InGraph))
+	{
+		ComponentFeatures.SetNum(Condensed.Num());
+		for (int32 Component = 0; Component < Condensed.Num(); ++Component)
+		{
+			for (const int32 Member : Condensed.GetMembers(Component))
+			{
+				AddCategories(Graph.Categories[Member], ComponentFeatures[Component]);
+				ComponentFeatures[Component].CalleeScore += Graph.CallSiteWeights[Member];
+			}
+		}
+	}
+
+	static uint64 MakeKey(int32 Component, int32 Depth)
+	{
+		return (static_cast<uint64>(Component) << 32) | static_cast<uint32>(Depth);
+	}
+
+	const FCognitiveComplexityFlatGraph& Graph;
+	const FCognitiveComplexityCondensedGraph Condensed;
+
+	/** Features of each component's exec members, without nesting or data flow. */
+	TArray<FCognitiveComplexityFeatures> ComponentFeatures;
+};
+
+FCognitiveComplexityCalculator::FCognitiveComplexityCalculator(const UBpCognitiveComplexitySettings& InSettings)
+	: Settings(InSettings)
+	, Weights(InSettings.GetWeights())
+	, bMemoizedScoring(InSettings.bMemoizedScoring)
+	, bWeightCallsByCallee(InSettings.bWeightCallsByCallee)
+	, bScoreDataFlow(InSettings.bScoreDataFlow)
+{
+}
+
+float FCognitiveComplexityCalculator::GetCategoryWeight(ECognitiveComplexityNodeCategory Categories) const
+{
+	float Weight = 0.0f;
+	for (uint32 Bits = static_cast<uint32>(Categories); Bits != 0; Bits &= Bits - 1)
+	{
+		Weight += Weights.Categories[FMath::CountTrailingZeros(Bits)];
+	}
+	return Weight;
+}
+
+void FCognitiveComplexityCalculator::AddCategories(ECognitiveComplexityNodeCategory Categories, FCognitiveComplexityFeatures& Features)
 {
-	static FName GetNodeClassName(const UEdGraphNode* Node)
+	// Indexed by the bit position of each ECognitiveComplexityNodeCategory flag, like the weights.
+	for (uint32 Bits = static_cast<uint32>(Categories); Bits != 0; Bits &= Bits - 1)
 	{
-		return Node ? Node->GetClass()->GetFName() : NAME_None;
+		Features.CategoryCounts[FMath::CountTrailingZeros(Bits)] += 1.0f;
 	}
+}
 
-	static bool NodeClassIsOneOf(const UEdGraphNode* Node, std::initializer_list<FName> Names)
+float FCognitiveComplexityCalculator::GetDataFlowWeight(ECognitiveComplexityNodeCategory Categories) const
+{
+	float Weight = 0.0f;
+	if (EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Math))
+	{
+		Weight += Weights.DataFlowMath;
+	}
+	if (EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::FunctionCall))
 	{
-		const FName ClassName = GetNodeClassName(Node);
-		for (FName Name : Names)
+		Weight += Weights.DataFlowCall;
+	}
+	return Weight;
+}
+
+void FCognitiveComplexityCalculator::AddDataFlow(ECognitiveComplexityNodeCategory Categories, FCognitiveComplexityFeatures& Features)
+{
+	if (EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Math))
+	{
+		Features.DataFlowMathCount += 1.0f;
+	}
+	if (EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::FunctionCall))
+	{
+		Features.DataFlowCallCount += 1.0f;
+	}
+}
+
+float FCognitiveComplexityCalculator::GetCallSiteWeight(const UEdGraphNode* Node) const
+{
+	return bWeightCallsByCallee && CallGraph != nullptr ? CallGraph->GetCallSiteScore(Node) : 0.0f;
+}
+
+template <typename ScoringType>
+auto FCognitiveComplexityCalculator::WithCallGraph(const UBlueprint* Blueprint, ScoringType&& Scoring) const
+{
+	if (!bWeightCallsByCallee || Blueprint == nullptr)
+	{
+		return Scoring(*this);
+	}
+
+	if (CallGraph != nullptr)
+	{
+		CallGraph->Resolve(Blueprint, *this);
+		return Scoring(*this);
+	}
+
+	FCognitiveComplexityCallGraph LocalCallGraph;
+	FCognitiveComplexityCalculator Scoped(Settings);
+	Scoped.CallGraph = &LocalCallGraph;
+	LocalCallGraph.Resolve(Blueprint, Scoped);
+	return Scoring(Scoped);
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::Calculate(const UEdGraphNode& EntryNode) const
+{
+	FWalkContext Context;
+	return Calculate(Context, EntryNode);
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::Calculate(const UEdGraphNode& EntryNode, TArray<FCognitiveComplexityNodeContribution>& OutContributions) const
+{
+	OutContributions.Reset();
+
+	const UEdGraph* Graph = EntryNode.GetGraph();
+	return WithCallGraph(Graph ? Graph->GetTypedOuter<UBlueprint>() : nullptr, [&EntryNode, &OutContributions](const FCognitiveComplexityCalculator& Calculator)
+	{
+		if (Calculator.bMemoizedScoring)
 		{
-			if (ClassName == Name)
-			{
-				return true;
-			}
+			return Calculator.CalculateMemoized(EntryNode, &OutContributions);
 		}
-		return false;
+
+		FWalkContext Context;
+		Context.Contributions = &OutContributions;
+		return Calculator.Calculate(Context, EntryNode);
+	});
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::Calculate(FWalkContext& Context, const UEdGraphNode& EntryNode) const
+{
+	// One scope and one counter update per entry walk; per WalkNode call they would cost more than the node itself.
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCalculator::Calculate);
+
+	WalkNode(Context, &EntryNode, /*Depth*/0);
+
+	INC_DWORD_STAT(STAT_BpCognitiveComplexity_EntriesScored);
+	INC_DWORD_STAT_BY(STAT_BpCognitiveComplexity_NodesVisited, Context.Visited.Num());
+
+	return MakeScore(Context.Features);
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::Calculate(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, FCognitiveComplexityMetricVisitor* Metrics) const
+{
+	if (!Graph.NodeGuids.IsValidIndex(EntryIndex))
+	{
+		return {};
+	}
+
+	return MakeScore(WalkFlatGraph(Graph, EntryIndex, Metrics, /*Contributions*/nullptr));
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::Calculate(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, TArray<FCognitiveComplexityNodeContribution>& OutContributions) const
+{
+	OutContributions.Reset();
+
+	if (!Graph.NodeGuids.IsValidIndex(EntryIndex))
+	{
+		return {};
 	}
 
-	static bool HasExecOutputs(const UEdGraphNode* Node)
+	if (bMemoizedScoring)
 	{
-		for (const UEdGraphPin* Pin : Node->Pins)
+		return CalculateMemoized(Graph, EntryIndex, &OutContributions);
+	}
+
+	return MakeScore(WalkFlatGraph(Graph, EntryIndex, /*Metrics*/nullptr, &OutContributions));
+}
+
+FCognitiveComplexityFeatures FCognitiveComplexityCalculator::WalkFlatGraph(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, FCognitiveComplexityMetricVisitor* Metrics, TArray<FCognitiveComplexityNodeContribution>* Contributions) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR("FCognitiveComplexityCalculator::Calculate (flat graph)");
+
+	TBitArray<> Visited(false, Graph.Num());
+	int32 NumVisited = 0;
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+	Stack.Emplace(EntryIndex, /*Depth*/0);
+
+	FCognitiveComplexityFeatures Features;
+
+	// Successors are pushed in reverse and the visited check happens on pop, which yields exactly
+	// the preorder of the recursive walk, so every node is scored at the same depth as in WalkNode.
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Item = Stack.Pop(EAllowShrinking::No);
+		const int32 NodeIndex = Item.Key;
+		const int32 Depth = Item.Value;
+
+		if (Visited[NodeIndex])
+		{
+			continue;
+		}
+
+		Visited[NodeIndex] = true;
+		++NumVisited;
+
+		const ECognitiveComplexityNodeCategory Categories = Graph.Categories[NodeIndex];
+		AddCategories(Categories, Features);
+		Features.CalleeScore += Graph.CallSiteWeights[NodeIndex];
+		Features.DepthSum += static_cast<float>(Depth);
+
+		if (Contributions != nullptr)
 		{
-			if (Pin && Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+			FCognitiveComplexityNodeContribution& Contribution = Contributions->AddDefaulted_GetRef();
+			Contribution.NodeGuid = Graph.NodeGuids[NodeIndex];
+			Contribution.BaseWeight = EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Entry) ? Weights.Categories[0] : 0.0f;
+			Contribution.CategoryWeight = GetCategoryWeight(Categories) + Graph.CallSiteWeights[NodeIndex] - Contribution.BaseWeight;
+			Contribution.NestingPenalty = Weights.NestingPenalty * Depth;
+		}
+
+		if (bScoreDataFlow)
+		{
+			// Pure nodes share the visited set: they are never reached over exec links.
+			Graph.ForEachDataInput(NodeIndex, [this, &Graph, &Visited, &NumVisited, &Features, Metrics, Contributions, Depth](int32 PureIndex)
 			{
+				if (Visited[PureIndex])
+				{
+					return false;
+				}
+
+				Visited[PureIndex] = true;
+				++NumVisited;
+				AddDataFlow(Graph.Categories[PureIndex], Features);
+
+				if (Metrics != nullptr)
+				{
+					Metrics->Visit({ Graph.Categories[PureIndex], Depth, /*NumExecLinks*/0, /*bPure*/true });
+				}
+
+				if (Contributions != nullptr)
+				{
+					FCognitiveComplexityNodeContribution& Contribution = Contributions->AddDefaulted_GetRef();
+					Contribution.NodeGuid = Graph.NodeGuids[PureIndex];
+					Contribution.DataFlowWeight = GetDataFlowWeight(Graph.Categories[PureIndex]);
+				}
 				return true;
+			});
+		}
+
+		const int32 NextDepth = FCognitiveComplexityNodeClassifier::IncreasesNesting(Categories) ? Depth + 1 : Depth;
+		const TConstArrayView<int32> Successors = Graph.GetSuccessors(NodeIndex);
+
+		if (Metrics != nullptr)
+		{
+			Metrics->Visit({ Categories, Depth, Successors.Num(), /*bPure*/false });
+		}
+
+		for (int32 SuccessorIndex = Successors.Num() - 1; SuccessorIndex >= 0; --SuccessorIndex)
+		{
+			if (!Visited[Successors[SuccessorIndex]])
+			{
+				Stack.Emplace(Successors[SuccessorIndex], NextDepth);
 			}
 		}
-		return false;
 	}
-}
 
-FCognitiveComplexityCalculator::FCognitiveComplexityCalculator(const UBpCognitiveComplexitySettings& InSettings)
-	: Settings(InSettings)
-{
+	INC_DWORD_STAT(STAT_BpCognitiveComplexity_EntriesScored);
+	INC_DWORD_STAT_BY(STAT_BpCognitiveComplexity_NodesVisited, NumVisited);
+
+	return Features;
 }
 
-FCognitiveComplexityScore FCognitiveComplexityCalculator::Calculate(const UEdGraphNode& EntryNode) const
+TArray<FCognitiveComplexityScore> FCognitiveComplexityCalculator::CalculateMemoized(const FCognitiveComplexityFlatGraph& Graph, TArray<FCognitiveComplexityFeatures>* OutFeatures, TArray<TArray<FCognitiveComplexityNodeContribution>>* OutContributions, TArray<FCognitiveComplexityMetrics>* OutMetrics) const
 {
-	Visited.Reset();
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCalculator::CalculateMemoized);
 
-	const float RawScore = WalkNode(&EntryNode, /*Depth*/0);
-	const float Percent = (RawScore / static_cast<float>(Settings.PercentScale)) * 100.0f;
+	const FMemoContext Memo(Graph);
 
-	FCognitiveComplexityScore Result;
-	Result.RawScore = RawScore;
-	Result.Percent = Percent;
-	return Result;
+	TArray<FCognitiveComplexityScore> Scores;
+	Scores.Reserve(Graph.EntryIndices.Num());
+	if (OutFeatures != nullptr)
+	{
+		OutFeatures->Reset(Graph.EntryIndices.Num());
+	}
+	if (OutContributions != nullptr)
+	{
+		OutContributions->Reset(Graph.EntryIndices.Num());
+	}
+	if (OutMetrics != nullptr)
+	{
+		OutMetrics->Reset(Graph.EntryIndices.Num());
+	}
+
+	for (const int32 EntryIndex : Graph.EntryIndices)
+	{
+		TArray<FCognitiveComplexityNodeContribution>* Contributions = OutContributions != nullptr ? &OutContributions->AddDefaulted_GetRef() : nullptr;
+		FCognitiveComplexityMetricVisitor Metrics;
+		const FCognitiveComplexityFeatures Features = WalkMemoized(Memo, EntryIndex, Contributions, OutMetrics != nullptr ? &Metrics : nullptr);
+		Scores.Add(MakeScore(Features));
+		if (OutFeatures != nullptr)
+		{
+			OutFeatures->Add(Features);
+		}
+		if (OutMetrics != nullptr)
+		{
+			OutMetrics->Add(Metrics.Finish());
+		}
+	}
+
+	return Scores;
 }
 
-float FCognitiveComplexityCalculator::WalkNode(const UEdGraphNode* Node, int32 Depth) const
+TArray<FCognitiveComplexityScore> FCognitiveComplexityCalculator::CalculateEntries(const FCognitiveComplexityFlatGraph& Graph, TArray<TArray<FCognitiveComplexityNodeContribution>>& OutContributions) const
 {
-	if (Node == nullptr || Visited.Contains(Node))
+	if (bMemoizedScoring)
 	{
-		return 0.0f;
+		return CalculateMemoized(Graph, /*OutFeatures*/nullptr, &OutContributions);
 	}
 
-	Visited.Add(Node);
+	TArray<FCognitiveComplexityScore> Scores;
+	Scores.Reserve(Graph.EntryIndices.Num());
+	OutContributions.Reset(Graph.EntryIndices.Num());
 
-	float Score = 0.0f;
-
-	// Base weight for entry nodes.
-	if (IsEntryNode(Node))
+	for (const int32 EntryIndex : Graph.EntryIndices)
 	{
-		Score += Settings.BaseEntryWeight;
+		Scores.Add(MakeScore(WalkFlatGraph(Graph, EntryIndex, /*Metrics*/nullptr, &OutContributions.AddDefaulted_GetRef())));
 	}
 
-	// Node-specific weights.
-	if (IsLoopNode(Node))
+	return Scores;
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::CalculateMemoized(const UEdGraphNode& EntryNode, TArray<FCognitiveComplexityNodeContribution>* OutContributions) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCalculator::CalculateMemoized);
+
+	const UEdGraph* Graph = EntryNode.GetGraph();
+	const FCognitiveComplexityFlatGraph FlatGraph = FCognitiveComplexityFlatGraph::Build(MakeArrayView(&Graph, 1), bWeightCallsByCallee ? CallGraph : nullptr);
+
+	const int32 EntryIndex = FlatGraph.NodeGuids.IndexOfByKey(EntryNode.NodeGuid);
+	if (EntryIndex == INDEX_NONE)
 	{
-		Score += Settings.LoopWeight;
+		return {};
 	}
 
-	if (IsBranchNode(Node))
+	return CalculateMemoized(FlatGraph, EntryIndex, OutContributions);
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::CalculateMemoized(const FCognitiveComplexityFlatGraph& FlatGraph, int32 EntryIndex, TArray<FCognitiveComplexityNodeContribution>* OutContributions) const
+{
+	const FMemoContext Memo(FlatGraph);
+	return MakeScore(WalkMemoized(Memo, EntryIndex, OutContributions));
+}
+
+FCognitiveComplexityFeatures FCognitiveComplexityCalculator::WalkMemoized(const FMemoContext& Memo, int32 EntryIndex, TArray<FCognitiveComplexityNodeContribution>* Contributions, FCognitiveComplexityMetricVisitor* Metrics) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR("FCognitiveComplexityCalculator::Calculate (memoized)");
+
+	// Every (component, depth) state counts once per entry however many exec paths converge on
+	// it, so the work and the score stay linear in the states even for long chains of diamonds.
+	TSet<uint64> Reached;
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+	Stack.Emplace(Memo.Condensed.ComponentOfNode[EntryIndex], /*Depth*/0);
+
+	FCognitiveComplexityFeatures Features;
+	TMap<int32, FCognitiveComplexityNodeContribution> NodeContributions;
+	int32 NumVisited = 0;
+
+	// Components in the order they were first reached, and the deepest depth each is reached at.
+	TArray<int32, TInlineAllocator<64>> ReachedComponents;
+	TArray<int32> DeepestDepth;
+	DeepestDepth.Init(INDEX_NONE, Memo.Condensed.Num());
+
+	while (Stack.Num() > 0)
 	{
-		Score += Settings.BranchWeight;
+		const TPair<int32, int32> Item = Stack.Pop(EAllowShrinking::No);
+		const int32 Component = Item.Key;
+		const int32 Depth = Item.Value;
+
+		bool bAlreadyReached = false;
+		Reached.Add(FMemoContext::MakeKey(Component, Depth), &bAlreadyReached);
+		if (bAlreadyReached)
+		{
+			continue;
+		}
+
+		const TConstArrayView<int32> Members = Memo.Condensed.GetMembers(Component);
+		Features += Memo.ComponentFeatures[Component];
+		Features.DepthSum += static_cast<float>(Depth * Members.Num());
+		NumVisited += Members.Num();
+
+		if (DeepestDepth[Component] == INDEX_NONE)
+		{
+			ReachedComponents.Add(Component);
+		}
+		DeepestDepth[Component] = FMath::Max(DeepestDepth[Component], Depth);
+
+		if (Contributions != nullptr)
+		{
+			for (const int32 Member : Members)
+			{
+				const ECognitiveComplexityNodeCategory Categories = Memo.Graph.Categories[Member];
+				const float BaseWeight = EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Entry) ? Weights.Categories[0] : 0.0f;
+
+				FCognitiveComplexityNodeContribution& Contribution = NodeContributions.FindOrAdd(Member);
+				Contribution.NodeGuid = Memo.Graph.NodeGuids[Member];
+				Contribution.BaseWeight += BaseWeight;
+				Contribution.CategoryWeight += GetCategoryWeight(Categories) + Memo.Graph.CallSiteWeights[Member] - BaseWeight;
+				Contribution.NestingPenalty += Weights.NestingPenalty * Depth;
+			}
+		}
+
+		// Pushed in reverse so the first successor is walked first, as in the flat walk.
+		const TConstArrayView<int32> Successors = Memo.Condensed.GetSuccessors(Component);
+		const int32 FirstSuccessor = Memo.Condensed.SuccessorOffsets[Component];
+		for (int32 Index = Successors.Num() - 1; Index >= 0; --Index)
+		{
+			const int32 SuccessorDepth = Depth + Memo.Condensed.SuccessorNested[FirstSuccessor + Index];
+			if (!Reached.Contains(FMemoContext::MakeKey(Successors[Index], SuccessorDepth)))
+			{
+				Stack.Emplace(Successors[Index], SuccessorDepth);
+			}
+		}
 	}
 
-	if (IsSelectNode(Node))
+	// Metrics and pure inputs are taken once per reached node, after the walk, so they see every
+	// component at the deepest depth it is reached at whatever order the states were walked in.
+	// Pure nodes count once per entry, as in the flat walk, and report the depth of the first
+	// exec node found to read them.
+	if (Metrics != nullptr || bScoreDataFlow)
 	{
-		Score += Settings.SelectWeight;
+		TBitArray<> PureCounted(false, bScoreDataFlow ? Memo.Graph.Num() : 0);
+		for (const int32 Component : ReachedComponents)
+		{
+			const int32 Depth = DeepestDepth[Component];
+			for (const int32 Member : Memo.Condensed.GetMembers(Component))
+			{
+				if (Metrics != nullptr)
+				{
+					Metrics->Visit({ Memo.Graph.Categories[Member], Depth, Memo.Graph.GetSuccessors(Member).Num(), /*bPure*/false });
+				}
+
+				if (!bScoreDataFlow)
+				{
+					continue;
+				}
+
+				Memo.Graph.ForEachDataInput(Member, [this, &Memo, &PureCounted, &Features, &NodeContributions, Metrics, Contributions, Depth](int32 PureIndex)
+				{
+					if (PureCounted[PureIndex])
+					{
+						return false;
+					}
+
+					PureCounted[PureIndex] = true;
+					const ECognitiveComplexityNodeCategory PureCategories = Memo.Graph.Categories[PureIndex];
+					AddDataFlow(PureCategories, Features);
+
+					if (Metrics != nullptr)
+					{
+						Metrics->Visit({ PureCategories, Depth, /*NumExecLinks*/0, /*bPure*/true });
+					}
+
+					if (Contributions != nullptr)
+					{
+						FCognitiveComplexityNodeContribution& PureContribution = NodeContributions.FindOrAdd(PureIndex);
+						PureContribution.NodeGuid = Memo.Graph.NodeGuids[PureIndex];
+						PureContribution.DataFlowWeight = GetDataFlowWeight(PureCategories);
+					}
+					return true;
+				});
+			}
+		}
 	}
 
-	if (IsLatentNode(Node))
+	if (Contributions != nullptr)
 	{
-		Score += Settings.LatentWeight;
+		NodeContributions.KeySort(TLess<int32>());
+		NodeContributions.GenerateValueArray(*Contributions);
 	}
 
-	if (IsFunctionCallNode(Node))
+	INC_DWORD_STAT(STAT_BpCognitiveComplexity_EntriesScored);
+	INC_DWORD_STAT_BY(STAT_BpCognitiveComplexity_NodesVisited, NumVisited);
+
+	return Features;
+}
+
+FCognitiveComplexityScore FCognitiveComplexityCalculator::MakeScore(const FCognitiveComplexityFeatures& Features) const
+{
+	return Features.Evaluate(Weights);
+}
+
+void FCognitiveComplexityCalculator::WalkNode(FWalkContext& Context, const UEdGraphNode* Node, int32 Depth) const
+{
+	if (Node == nullptr || Context.Visited.Contains(Node))
 	{
-		Score += Settings.FunctionCallWeight;
+		return;
 	}
-	else if (IsMathNode(Node))
+
+	Context.Visited.Add(Node);
+
+	const ECognitiveComplexityNodeCategory Categories = FCognitiveComplexityNodeClassifier::Classify(Node);
+	const float CallSiteWeight = GetCallSiteWeight(Node);
+
+	// Node-specific categories plus nesting depth.
+	AddCategories(Categories, Context.Features);
+	Context.Features.CalleeScore += CallSiteWeight;
+	Context.Features.DepthSum += static_cast<float>(Depth);
+
+	if (Context.Contributions != nullptr)
 	{
-		Score += Settings.MathNodeWeight;
+		FCognitiveComplexityNodeContribution& Contribution = Context.Contributions->AddDefaulted_GetRef();
+		Contribution.NodeGuid = Node->NodeGuid;
+		Contribution.BaseWeight = EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Entry) ? Weights.Categories[0] : 0.0f;
+		Contribution.CategoryWeight = GetCategoryWeight(Categories) + CallSiteWeight - Contribution.BaseWeight;
+		Contribution.NestingPenalty = Weights.NestingPenalty * Depth;
 	}
 
-	// Nesting penalty.
-	Score += static_cast<float>(Settings.NestingPenalty * Depth);
+	if (bScoreDataFlow)
+	{
+		WalkDataInputs(Context, Node, Depth);
+	}
 
 	// Traverse exec outputs.
-	const bool bIncreaseDepth = IsLoopNode(Node) || IsBranchNode(Node) || IsSelectNode(Node);
-	const int32 NextDepth = bIncreaseDepth ? Depth + 1 : Depth;
+	const int32 NextDepth = FCognitiveComplexityNodeClassifier::IncreasesNesting(Categories) ? Depth + 1 : Depth;
+	int32 NumExecLinks = 0;
 
 	for (const UEdGraphPin* Pin : Node->Pins)
 	{
@@ -142,135 +553,361 @@ float FCognitiveComplexityCalculator::WalkNode(const UEdGraphNode* Node, int32 D
 			}
 
 			const UEdGraphNode* LinkedNode = Linked->GetOwningNode();
-			Score += WalkNode(LinkedNode, NextDepth);
+			NumExecLinks += LinkedNode != nullptr ? 1 : 0;
+			WalkNode(Context, LinkedNode, NextDepth);
 		}
 	}
 
-	return Score;
+	// Visited after its successors; accumulators do not depend on the order.
+	if (Context.Metrics != nullptr)
+	{
+		Context.Metrics->Visit({ Categories, Depth, NumExecLinks, /*bPure*/false });
+	}
 }
 
-bool FCognitiveComplexityCalculator::IsBranchNode(const UEdGraphNode* Node) const
+void FCognitiveComplexityCalculator::WalkDataInputs(FWalkContext& Context, const UEdGraphNode* Node, int32 Depth) const
 {
-	return CognitiveComplexity::NodeClassIsOneOf(Node, { TEXT("K2Node_IfThenElse"), TEXT("K2Node_ExecutionSequence"), TEXT("K2Node_MultiGate") });
+	TArray<const UEdGraphNode*, TInlineAllocator<32>> Stack;
+
+	auto PushPureInputs = [&Stack](const UEdGraphNode* Consumer)
+	{
+		for (const UEdGraphPin* Pin : Consumer->Pins)
+		{
+			if (Pin == nullptr || Pin->Direction != EGPD_Input || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+			{
+				continue;
+			}
+
+			for (const UEdGraphPin* Linked : Pin->LinkedTo)
+			{
+				const UEdGraphNode* Source = Linked ? Linked->GetOwningNode() : nullptr;
+				if (Source != nullptr && FCognitiveComplexityNodeClassifier::IsPure(Source))
+				{
+					Stack.Add(Source);
+				}
+			}
+		}
+	};
+
+	// Pure nodes share the visited set with exec nodes: they are never reached over exec links,
+	// and a pure node already counted for an earlier node of this walk is not expanded again.
+	PushPureInputs(Node);
+	while (Stack.Num() > 0)
+	{
+		const UEdGraphNode* PureNode = Stack.Pop(EAllowShrinking::No);
+
+		bool bAlreadyVisited = false;
+		Context.Visited.Add(PureNode, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			continue;
+		}
+
+		const ECognitiveComplexityNodeCategory PureCategories = FCognitiveComplexityNodeClassifier::Classify(PureNode);
+		AddDataFlow(PureCategories, Context.Features);
+
+		if (Context.Metrics != nullptr)
+		{
+			Context.Metrics->Visit({ PureCategories, Depth, /*NumExecLinks*/0, /*bPure*/true });
+		}
+
+		if (Context.Contributions != nullptr)
+		{
+			FCognitiveComplexityNodeContribution& Contribution = Context.Contributions->AddDefaulted_GetRef();
+			Contribution.NodeGuid = PureNode->NodeGuid;
+			Contribution.DataFlowWeight = GetDataFlowWeight(PureCategories);
+		}
+
+		PushPureInputs(PureNode);
+	}
 }
 
-bool FCognitiveComplexityCalculator::IsSelectNode(const UEdGraphNode* Node) const
+TArray<FCognitiveComplexityEntryResult> FCognitiveComplexityCalculator::ProcessGraph(const UEdGraph* Graph) const
 {
-	return CognitiveComplexity::NodeClassIsOneOf(Node, { TEXT("K2Node_Select"), TEXT("K2Node_SwitchInteger"), TEXT("K2Node_SwitchEnum"), TEXT("K2Node_SwitchName"), TEXT("K2Node_SwitchString"), TEXT("K2Node_Switch") });
+	if (!Graph)
+	{
+		return {};
+	}
+
+	return WithCallGraph(Graph->GetTypedOuter<UBlueprint>(), [Graph](const FCognitiveComplexityCalculator& Calculator)
+	{
+		return Calculator.ProcessEntries(MakeArrayView(&Graph, 1));
+	});
 }
 
-bool FCognitiveComplexityCalculator::IsLoopNode(const UEdGraphNode* Node) const
+TArray<FCognitiveComplexityEntryResult> FCognitiveComplexityCalculator::ProcessBlueprint(const UBlueprint* Blueprint) const
 {
-	const FName ClassName = CognitiveComplexity::GetNodeClassName(Node);
-
-	// Native loop-style nodes.
-	if (ClassName.ToString().Contains(TEXT("ForLoop")) || ClassName.ToString().Contains(TEXT("WhileLoop")))
+	if (!Blueprint)
 	{
-		return true;
+		return {};
 	}
 
-	// ForEach nodes shipped as separate classes.
-	if (CognitiveComplexity::NodeClassIsOneOf(Node, { TEXT("K2Node_MapForEach"), TEXT("K2Node_SetForEach"), TEXT("K2Node_ForEachElementInEnum") }))
+	SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_ProcessBlueprint);
+
+	// Ubergraph pages first, then function graphs, matching the order results were always reported in.
+	TArray<const UEdGraph*, TInlineAllocator<16>> Graphs;
+	Graphs.Append(Blueprint->UbergraphPages);
+	Graphs.Append(Blueprint->FunctionGraphs);
+
+	return WithCallGraph(Blueprint, [&Graphs](const FCognitiveComplexityCalculator& Calculator)
 	{
-		return true;
-	}
+		return Calculator.ProcessEntries(Graphs);
+	});
+}
+
+TArray<FCognitiveComplexityEntryResult> FCognitiveComplexityCalculator::ProcessEntries(TConstArrayView<const UEdGraph*> Graphs) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_ScoreEntries);
+
+	TArray<FCognitiveComplexityEntryResult> Results;
+	TArray<const UEdGraphNode*> EntryNodes;
 
-	// Macro-based loop implementations (e.g. standard library ForLoop/WhileLoop macros).
-	if (ClassName == TEXT("K2Node_MacroInstance"))
+	// Titles go through FText formatting and the node title cache, so resolve them on the calling thread.
+	for (const UEdGraph* Graph : Graphs)
 	{
-		const FString Title = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
-		if (Title.Contains(TEXT("ForLoop")) || Title.Contains(TEXT("ForEach")) || Title.Contains(TEXT("While")))
+		if (!Graph)
 		{
-			return true;
+			continue;
 		}
+
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && EnumHasAnyFlags(FCognitiveComplexityNodeClassifier::Classify(Node), ECognitiveComplexityNodeCategory::Entry))
+			{
+				FCognitiveComplexityEntryResult& Result = Results.AddDefaulted_GetRef();
+				Result.NodeGuid = Node->NodeGuid;
+				Result.EntryDisplayName = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+				EntryNodes.Add(Node);
+			}
+		}
+	}
+
+	// Memoized mode condenses the graph once for all entries, so they are scored together. Each
+	// entry still walks every (component, depth) state it reaches on its own.
+	if (bMemoizedScoring)
+	{
+		// The flat graph numbers entries with the same filter and order as the loop above.
+		const FCognitiveComplexityFlatGraph FlatGraph = FCognitiveComplexityFlatGraph::Build(Graphs, bWeightCallsByCallee ? CallGraph : nullptr);
+		ScoreFlatEntries(FlatGraph, Results);
+		return Results;
 	}
 
-	return false;
+	// Each entry walks with its own context, so entries are independent work items.
+	ParallelFor(EntryNodes.Num(), [this, &EntryNodes, &Results](int32 Index)
+	{
+		FCognitiveComplexityMetricVisitor Metrics;
+		FWalkContext Context;
+		Context.Metrics = &Metrics;
+
+		Results[Index].Score = Calculate(Context, *EntryNodes[Index]);
+		Results[Index].Features = Context.Features;
+		Results[Index].bHasFeatures = true;
+		Results[Index].Metrics = Metrics.Finish();
+		Results[Index].bHasMetrics = true;
+	});
+
+	return Results;
 }
 
-bool FCognitiveComplexityCalculator::IsLatentNode(const UEdGraphNode* Node) const
+FCognitiveComplexitySnapshot FCognitiveComplexityCalculator::CaptureBlueprint(const UBlueprint* Blueprint) const
 {
-	// Check for latent/async nodes - using class name string comparison as fallback for classes without headers
-	const FName ClassName = CognitiveComplexity::GetNodeClassName(Node);
-	const FString ClassNameStr = ClassName.ToString();
-
-	if (ClassName == TEXT("K2Node_Timeline") || ClassName == TEXT("K2Node_BaseAsyncTask") || ClassName == TEXT("K2Node_AsyncAction"))
+	if (!Blueprint)
 	{
-		return true;
+		return {};
 	}
 
-	return ClassNameStr.Contains(TEXT("LatentGameplayCall")) || ClassNameStr.Contains(TEXT("AsyncTask"));
-}
+	TArray<const UEdGraph*, TInlineAllocator<16>> Graphs;
+	Graphs.Append(Blueprint->UbergraphPages);
+	Graphs.Append(Blueprint->FunctionGraphs);
 
-bool FCognitiveComplexityCalculator::IsFunctionCallNode(const UEdGraphNode* Node) const
-{
-	return Node->IsA<UK2Node_CallFunction>();
+	return Capture(Graphs);
 }
 
-bool FCognitiveComplexityCalculator::IsMathNode(const UEdGraphNode* Node) const
+FCognitiveComplexitySnapshot FCognitiveComplexityCalculator::CaptureGraph(const UEdGraph* Graph) const
 {
-	// Math expression nodes or generic pure nodes with no exec pins.
-	const UK2Node* K2Node = Cast<UK2Node>(Node);
-	return Node->IsA<UK2Node_MathExpression>() || Node->IsA<UK2Node_CommutativeAssociativeBinaryOperator>() || (K2Node && !CognitiveComplexity::HasExecOutputs(Node) && K2Node->IsNodePure());
+	if (!Graph)
+	{
+		return {};
+	}
+
+	return Capture(MakeArrayView(&Graph, 1));
 }
 
-bool FCognitiveComplexityCalculator::IsEntryNode(const UEdGraphNode* Node) const
+FCognitiveComplexitySnapshot FCognitiveComplexityCalculator::Capture(TConstArrayView<const UEdGraph*> Graphs) const
 {
-	return CognitiveComplexity::NodeClassIsOneOf(Node, { TEXT("K2Node_Event"), TEXT("K2Node_FunctionEntry") });
+	check(IsInGameThread());
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCalculator::Capture);
+
+	FCognitiveComplexitySnapshot Snapshot;
+	Snapshot.Graph = FCognitiveComplexityFlatGraph::Build(Graphs);
+
+	Snapshot.EntryDisplayNames.Reserve(Snapshot.Graph.EntryIndices.Num());
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && EnumHasAnyFlags(FCognitiveComplexityNodeClassifier::Classify(Node), ECognitiveComplexityNodeCategory::Entry))
+			{
+				Snapshot.EntryDisplayNames.Add(Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			}
+		}
+	}
+
+	check(Snapshot.EntryDisplayNames.Num() == Snapshot.Graph.EntryIndices.Num());
+
+	if (bWeightCallsByCallee)
+	{
+		// Only memoized callee scores are read here; everything else is scored with the snapshot.
+		FCognitiveComplexityCallGraph::CaptureCallees(Graphs, CallGraph, Snapshot);
+		Snapshot.CalleePackages = FCognitiveComplexityCallGraph::CollectCalleePackages(Graphs);
+	}
+
+	return Snapshot;
 }
 
-TArray<FCognitiveComplexityEntryResult> FCognitiveComplexityCalculator::ProcessGraph(const UEdGraph* Graph) const
+void FCognitiveComplexityCalculator::ResolveCallees(FCognitiveComplexitySnapshot& Snapshot) const
 {
-	TArray<FCognitiveComplexityEntryResult> Results;
-
-	if (!Graph)
+	if (!Snapshot.HasPendingCallees())
 	{
-		return Results;
+		return;
 	}
 
-	for (UEdGraphNode* Node : Graph->Nodes)
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCalculator::ResolveCallees);
+
+	enum class ECalleeState : uint8
+	{
+		Pending,
+		InProgress,
+		Scored,
+	};
+
+	FCognitiveComplexityFlatGraph& CalleeGraph = Snapshot.CalleeGraph;
+	const int32 NumCallees = Snapshot.CalleeEntries.Num();
+
+	TArray<float>& Scores = Snapshot.ResolvedCallees.Scores;
+	Scores.Init(0.0f, NumCallees);
+	TArray<ECalleeState> States;
+	States.Init(ECalleeState::Pending, NumCallees);
+
+	auto GetCallSites = [&Snapshot](int32 Callee)
 	{
-		if (!Node)
+		const int32 First = Snapshot.CalleeCallSiteOffsets[Callee];
+		return MakeArrayView(Snapshot.CalleeCallSites.GetData() + First, Snapshot.CalleeCallSiteOffsets[Callee + 1] - First);
+	};
+
+	// Depth-first, scoring each callee once all of its own callees are scored. The capture already
+	// dropped the call sites Resolve counts as recursive, so the captured callees form a DAG.
+	TArray<TPair<int32, int32>, TInlineAllocator<16>> Stack;
+	for (int32 Root = 0; Root < NumCallees; ++Root)
+	{
+		if (States[Root] != ECalleeState::Pending)
 		{
 			continue;
 		}
 
-		if (IsEntryNode(Node))
+		States[Root] = ECalleeState::InProgress;
+		Stack.Emplace(Root, 0);
+
+		while (Stack.Num() > 0)
 		{
-			const FCognitiveComplexityScore Score = Calculate(*Node);
-			
-			FCognitiveComplexityEntryResult Result;
-			Result.NodeGuid = Node->NodeGuid;
-			Result.EntryDisplayName = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
-			Result.Score = Score;
-			
-			Results.Add(Result);
+			const int32 Callee = Stack.Last().Key;
+			const int32 CallSiteIndex = Stack.Last().Value++;
+			const TConstArrayView<FCognitiveComplexitySnapshotCallSite> CallSites = GetCallSites(Callee);
+
+			if (CallSites.IsValidIndex(CallSiteIndex))
+			{
+				const int32 Target = CallSites[CallSiteIndex].Callee;
+				if (States[Target] == ECalleeState::Pending)
+				{
+					States[Target] = ECalleeState::InProgress;
+					Stack.Emplace(Target, 0);
+				}
+				continue;
+			}
+
+			for (const FCognitiveComplexitySnapshotCallSite& CallSite : CallSites)
+			{
+				if (States[CallSite.Callee] == ECalleeState::Scored)
+				{
+					CalleeGraph.CallSiteWeights[CallSite.NodeIndex] = Scores[CallSite.Callee];
+				}
+			}
+
+			const int32 Entry = Snapshot.CalleeEntries[Callee];
+			Scores[Callee] = Entry != INDEX_NONE ? MakeScore(WalkFlatGraph(CalleeGraph, Entry, /*Metrics*/nullptr, /*Contributions*/nullptr)).RawScore : 0.0f;
+			States[Callee] = ECalleeState::Scored;
+			Stack.Pop(EAllowShrinking::No);
 		}
 	}
 
-	return Results;
+	for (const FCognitiveComplexitySnapshotCallSite& CallSite : Snapshot.PendingCallSites)
+	{
+		Snapshot.Graph.CallSiteWeights[CallSite.NodeIndex] = Scores[CallSite.Callee];
+	}
+
+	// Only the weights in Graph and the resolved scores are needed from here on.
+	Snapshot.CalleeGraph = FCognitiveComplexityFlatGraph();
+	Snapshot.CalleeEntries.Empty();
+	Snapshot.CalleeCallSiteOffsets.Empty();
+	Snapshot.CalleeCallSites.Empty();
+	Snapshot.PendingCallSites.Empty();
 }
 
-TArray<FCognitiveComplexityEntryResult> FCognitiveComplexityCalculator::ProcessBlueprint(const UBlueprint* Blueprint) const
+TArray<FCognitiveComplexityEntryResult> FCognitiveComplexityCalculator::ProcessSnapshot(const FCognitiveComplexitySnapshot& Snapshot) const
 {
-	TArray<FCognitiveComplexityEntryResult> Results;
+	SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_ScoreEntries);
+	checkf(!Snapshot.HasPendingCallees(), TEXT("ResolveCallees must run before a snapshot is scored."));
 
-	if (!Blueprint)
+	const FCognitiveComplexityFlatGraph& Graph = Snapshot.Graph;
+
+	TArray<FCognitiveComplexityEntryResult> Results;
+	Results.SetNum(Graph.EntryIndices.Num());
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
 	{
-		return Results;
+		Results[Index].NodeGuid = Graph.NodeGuids[Graph.EntryIndices[Index]];
+		Results[Index].EntryDisplayName = Snapshot.EntryDisplayNames[Index];
 	}
 
-	// Process all Ubergraph pages
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	if (bMemoizedScoring)
 	{
-		Results.Append(ProcessGraph(Graph));
+		ScoreFlatEntries(Graph, Results);
+		return Results;
 	}
 
-	// Process all function graphs
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	// The flat walk visits nodes in the same order and at the same depths as WalkNode.
+	ParallelFor(Results.Num(), [this, &Graph, &Results](int32 Index)
 	{
-		Results.Append(ProcessGraph(Graph));
-	}
+		FCognitiveComplexityMetricVisitor Metrics;
+		const FCognitiveComplexityFeatures Features = WalkFlatGraph(Graph, Graph.EntryIndices[Index], &Metrics, /*Contributions*/nullptr);
+
+		Results[Index].Score = MakeScore(Features);
+		Results[Index].Features = Features;
+		Results[Index].bHasFeatures = true;
+		Results[Index].Metrics = Metrics.Finish();
+		Results[Index].bHasMetrics = true;
+	});
 
 	return Results;
 }
+
+void FCognitiveComplexityCalculator::ScoreFlatEntries(const FCognitiveComplexityFlatGraph& Graph, TArray<FCognitiveComplexityEntryResult>& Results) const
+{
+	TArray<FCognitiveComplexityFeatures> Features;
+	TArray<FCognitiveComplexityMetrics> Metrics;
+	const TArray<FCognitiveComplexityScore> Scores = CalculateMemoized(Graph, &Features, /*OutContributions*/nullptr, &Metrics);
+
+	check(Scores.Num() == Results.Num());
+	for (int32 Index = 0; Index < Results.Num(); ++Index)
+	{
+		Results[Index].Score = Scores[Index];
+		Results[Index].Features = Features[Index];
+		Results[Index].bHasFeatures = true;
+		Results[Index].Metrics = Metrics[Index];
+		Results[Index].bHasMetrics = true;
+	}
+}
@@ -1,42 +1,205 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CognitiveComplexityNodeClassifier.h"
 #include "CognitiveComplexityTypes.h"
 
 class UEdGraphNode;
 class UEdGraph;
 class UBlueprint;
 class UBpCognitiveComplexitySettings;
+struct FCognitiveComplexityFlatGraph;
+class FCognitiveComplexityCallGraph;
+class FCognitiveComplexityMetricVisitor;
+struct FCognitiveComplexitySnapshot;
 
 /**
  * Traverses a Blueprint graph starting from an entry node to estimate
  * cognitive complexity according to configurable weights.
+ *
+ * The calculator holds no traversal state of its own: every Calculate call walks with
+ * its own context, so one instance can score several entries concurrently. It copies the
+ * settings it scores with when constructed, so a copy can score flat graphs and snapshots
+ * on a worker thread while the settings are edited.
+ *
+ * With bMemoizedScoring set, entries are scored on the graph's strongly connected components
+ * instead: every component adds its weight plus the nesting penalty once for each depth it is
+ * reached at, however many exec paths converge on it, so the result no longer depends on which
+ * pin is visited first. The condensation and the per-component weights are computed once per
+ * flattened graph and shared by all of its entries; the walk over the reached states is not, so
+ * a chain shared by several entries is walked once per entry.
+ *
+ * With bWeightCallsByCallee set, calls to Blueprint functions and macro instances also add the
+ * callee's own score, taken from a call graph resolved before the entries are scored.
+ *
+ * With bScoreDataFlow set, every reached exec node also adds the data-flow weights of the pure
+ * nodes feeding its inputs. Pure nodes are memoized per walk, so a subexpression shared by
+ * several inputs or nodes counts once per entry and wide expression DAGs stay linear.
+ *
+ * Every walk accumulates FCognitiveComplexityFeatures rather than a weighted sum, and the score
+ * is their dot product with the weights, so ProcessGraph and ProcessBlueprint can hand out
+ * features that score the same entries under other weights without walking them again.
+ *
+ * The same walk also feeds every node it reaches to an FCognitiveComplexityMetricVisitor, so the
+ * structural metrics in FCognitiveComplexityMetrics cost no traversal of their own. The memoized
+ * walk feeds every node once, at the deepest depth its component is reached at, so its metrics do
+ * not depend on pin order either.
  */
 class FCognitiveComplexityCalculator
 {
 public:
 	explicit FCognitiveComplexityCalculator(const UBpCognitiveComplexitySettings& InSettings);
 
-	/** Calculates complexity for a given entry node (event/function). */
+	/**
+	 * Call graph to resolve Blueprints into when calls are weighted by their callee, so callee
+	 * scores are memoized across Blueprints (e.g. for a whole scan). Without one, each
+	 * ProcessBlueprint resolves a temporary call graph.
+	 */
+	void SetCallGraph(FCognitiveComplexityCallGraph* InCallGraph) { CallGraph = InCallGraph; }
+
+	/** Calculates complexity for a given entry node (event/function). Always uses the per-entry walk. */
 	FCognitiveComplexityScore Calculate(const UEdGraphNode& EntryNode) const;
 
-	/** Processes a graph and returns all entry node results. */
+	/**
+	 * Same as Calculate, also recording what every node reached from the entry added to the score,
+	 * in visit order. The contributions are collected by the scoring walk itself. Honours
+	 * bMemoizedScoring, in which case it must run on the game thread.
+	 */
+	FCognitiveComplexityScore Calculate(const UEdGraphNode& EntryNode, TArray<FCognitiveComplexityNodeContribution>& OutContributions) const;
+
+	/**
+	 * Scores an entry of a flattened graph with an iterative walk over its CSR successor lists.
+	 * Produces the same score as Calculate on the source node without recursing per exec link.
+	 * Every reached node is also fed to Metrics, if given.
+	 */
+	FCognitiveComplexityScore Calculate(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, FCognitiveComplexityMetricVisitor* Metrics = nullptr) const;
+
+	/**
+	 * Scores an entry of a flattened graph and records what every reached node added to the score,
+	 * like the UEdGraphNode overload. Honours bMemoizedScoring and never touches UObjects, so it is
+	 * safe on any thread.
+	 */
+	FCognitiveComplexityScore Calculate(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, TArray<FCognitiveComplexityNodeContribution>& OutContributions) const;
+
+	/**
+	 * Scores every entry of a flattened graph and records the contributions of each, like the
+	 * single-entry overload but condensing the graph once for all entries in memoized mode.
+	 * Results follow Graph.EntryIndices. Safe on any thread.
+	 */
+	TArray<FCognitiveComplexityScore> CalculateEntries(const FCognitiveComplexityFlatGraph& Graph, TArray<TArray<FCognitiveComplexityNodeContribution>>& OutContributions) const;
+
+	/**
+	 * Scores every entry of a flattened graph in memoized mode, regardless of the setting.
+	 * Results follow Graph.EntryIndices; the metrics are collected by the same walk.
+	 */
+	TArray<FCognitiveComplexityScore> CalculateMemoized(const FCognitiveComplexityFlatGraph& Graph, TArray<FCognitiveComplexityFeatures>* OutFeatures = nullptr, TArray<TArray<FCognitiveComplexityNodeContribution>>* OutContributions = nullptr, TArray<FCognitiveComplexityMetrics>* OutMetrics = nullptr) const;
+
+	/** Processes a graph and returns all entry node results. Entries are scored in parallel. */
 	TArray<FCognitiveComplexityEntryResult> ProcessGraph(const UEdGraph* Graph) const;
 
-	/** Processes a Blueprint and returns all entry node results from all graphs. */
+	/** Processes a Blueprint and returns all entry node results from all graphs. Entries are scored in parallel. */
 	TArray<FCognitiveComplexityEntryResult> ProcessBlueprint(const UBlueprint* Blueprint) const;
 
+	/**
+	 * Copies what ProcessBlueprint needs out of the Blueprint's graphs. If calls are weighted by their
+	 * callee, it also copies the function and macro graphs they reach whose scores the call graph has
+	 * not memoized, for ResolveCallees. Must run on the game thread; it is one pass over the nodes
+	 * and pins, much cheaper than scoring.
+	 */
+	FCognitiveComplexitySnapshot CaptureBlueprint(const UBlueprint* Blueprint) const;
+
+	/** Same as CaptureBlueprint for a single graph. */
+	FCognitiveComplexitySnapshot CaptureGraph(const UEdGraph* Graph) const;
+
+	/**
+	 * Scores the callee graphs a snapshot captured, callees first, and copies their scores into its
+	 * call sites. Must run before a snapshot is scored. Safe on any thread.
+	 */
+	void ResolveCallees(FCognitiveComplexitySnapshot& Snapshot) const;
+
+	/**
+	 * Scores every entry of a snapshot with the same results as ProcessBlueprint on the graphs it
+	 * was captured from. Safe on any thread, once ResolveCallees ran.
+	 */
+	TArray<FCognitiveComplexityEntryResult> ProcessSnapshot(const FCognitiveComplexitySnapshot& Snapshot) const;
+
 private:
-	float WalkNode(const UEdGraphNode* Node, int32 Depth) const;
+	/** Per-call traversal state. */
+	struct FWalkContext
+	{
+		TSet<const UEdGraphNode*> Visited;
+
+		/** Side table filled while walking, or null when only the total is wanted. Pure nodes get their own rows. */
+		TArray<FCognitiveComplexityNodeContribution>* Contributions = nullptr;
+
+		/** Everything the walk counted so far. */
+		FCognitiveComplexityFeatures Features;
+
+		/** Receives every reached node, or null when no metrics are wanted. */
+		FCognitiveComplexityMetricVisitor* Metrics = nullptr;
+	};
+
+	/** Condensation and per-component features of one flattened graph, shared by all of its entries. */
+	struct FMemoContext;
+
+	FCognitiveComplexityScore Calculate(FWalkContext& Context, const UEdGraphNode& EntryNode) const;
 
-	bool IsBranchNode(const UEdGraphNode* Node) const;
-	bool IsSelectNode(const UEdGraphNode* Node) const;
-	bool IsLoopNode(const UEdGraphNode* Node) const;
-	bool IsLatentNode(const UEdGraphNode* Node) const;
-	bool IsFunctionCallNode(const UEdGraphNode* Node) const;
-	bool IsMathNode(const UEdGraphNode* Node) const;
-	bool IsEntryNode(const UEdGraphNode* Node) const;
+	/** Iterative preorder walk of a flat graph entry, feeding Metrics and Contributions if given. */
+	FCognitiveComplexityFeatures WalkFlatGraph(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, FCognitiveComplexityMetricVisitor* Metrics, TArray<FCognitiveComplexityNodeContribution>* Contributions) const;
+
+	/** Scores the entries of a flat graph in memoized mode, with their metrics, into Results, which are in EntryIndices order. */
+	void ScoreFlatEntries(const FCognitiveComplexityFlatGraph& Graph, TArray<FCognitiveComplexityEntryResult>& Results) const;
+
+	/** Flattens Graphs, captures the callees of their call sites and titles every entry. */
+	FCognitiveComplexitySnapshot Capture(TConstArrayView<const UEdGraph*> Graphs) const;
+
+	/**
+	 * Memoized score of one entry node, flattening the graph that owns it. Must run on the game thread.
+	 * Both overloads condense the graph for this one entry; CalculateEntries shares that between entries.
+	 */
+	FCognitiveComplexityScore CalculateMemoized(const UEdGraphNode& EntryNode, TArray<FCognitiveComplexityNodeContribution>* OutContributions) const;
+	FCognitiveComplexityScore CalculateMemoized(const FCognitiveComplexityFlatGraph& Graph, int32 EntryIndex, TArray<FCognitiveComplexityNodeContribution>* OutContributions) const;
+
+	/**
+	 * Walks the (component, depth) states reachable from an entry, each once, feeding Contributions
+	 * if given. Metrics, if given, sees every reached exec node once, at the deepest state that reaches it.
+	 */
+	FCognitiveComplexityFeatures WalkMemoized(const FMemoContext& Memo, int32 EntryIndex, TArray<FCognitiveComplexityNodeContribution>* Contributions, FCognitiveComplexityMetricVisitor* Metrics = nullptr) const;
+
+	FCognitiveComplexityScore MakeScore(const FCognitiveComplexityFeatures& Features) const;
+	void WalkNode(FWalkContext& Context, const UEdGraphNode* Node, int32 Depth) const;
+
+	/** Counts the pure nodes feeding a node's data inputs that the walk has not counted yet. */
+	void WalkDataInputs(FWalkContext& Context, const UEdGraphNode* Node, int32 Depth) const;
+
+	/** Data-flow weight of a pure node with these categories. */
+	float GetDataFlowWeight(ECognitiveComplexityNodeCategory Categories) const;
+
+	/** Adds one to the count of every category bit set. */
+	static void AddCategories(ECognitiveComplexityNodeCategory Categories, FCognitiveComplexityFeatures& Features);
+
+	/** Adds one to the data-flow counts a pure node with these categories weighs on. */
+	static void AddDataFlow(ECognitiveComplexityNodeCategory Categories, FCognitiveComplexityFeatures& Features);
+
+	/** Collects entry nodes in graph order and scores them, fanning out across worker threads. */
+	TArray<FCognitiveComplexityEntryResult> ProcessEntries(TConstArrayView<const UEdGraph*> Graphs) const;
+
+	/** Sum of the weights of every category bit set. */
+	float GetCategoryWeight(ECognitiveComplexityNodeCategory Categories) const;
+
+	/** Callee score added to a call site, or 0 when calls are not weighted by their callee. */
+	float GetCallSiteWeight(const UEdGraphNode* Node) const;
+
+	/** Resolves the Blueprint's call graph if calls are weighted by their callee, then runs Scoring with a calculator using it. */
+	template <typename ScoringType>
+	auto WithCallGraph(const UBlueprint* Blueprint, ScoringType&& Scoring) const;
 
 	const UBpCognitiveComplexitySettings& Settings;
-	mutable TSet<const UEdGraphNode*> Visited;
+	FCognitiveComplexityCallGraph* CallGraph = nullptr;
+	FCognitiveComplexityWeights Weights;
+	bool bMemoizedScoring = false;
+	bool bWeightCallsByCallee = false;
+	bool bScoreDataFlow = false;
+
+	static_assert(FCognitiveComplexityWeights::NumCategories == FCognitiveComplexityNodeClassifier::NumCategories, "One weight per node category");
 };
@@ -0,0 +1,474 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityCallGraph.h"
+
+#include "BpCognitiveComplexity.h"
+#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityNodeClassifier.h"
+#include "CognitiveComplexitySnapshot.h"
+#include "CognitiveComplexityStats.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Tunnel.h"
+#include "UObject/Package.h"
+
+namespace CognitiveComplexityCallGraph
+{
+	/** Node a callee graph is scored from: the function entry, or the entry tunnel of a macro. */
+	static const UEdGraphNode* FindCalleeEntry(const UEdGraph* Callee)
+	{
+		for (const UEdGraphNode* Node : Callee->Nodes)
+		{
+			if (Node == nullptr)
+			{
+				continue;
+			}
+
+			if (EnumHasAnyFlags(FCognitiveComplexityNodeClassifier::Classify(Node), ECognitiveComplexityNodeCategory::Entry))
+			{
+				return Node;
+			}
+
+			const UK2Node_Tunnel* Tunnel = Cast<UK2Node_Tunnel>(Node);
+			if (Tunnel != nullptr && Tunnel->DrawNodeAsEntry())
+			{
+				return Node;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/** Graphs Resolve walks the call sites of: the Blueprint's event graphs, then its function graphs. */
+	static void GetRoots(const UBlueprint* Blueprint, TArray<const UEdGraph*, TInlineAllocator<16>>& OutRoots)
+	{
+		OutRoots.Append(Blueprint->UbergraphPages);
+		OutRoots.Append(Blueprint->FunctionGraphs);
+	}
+}
+
+void FCognitiveComplexityCallGraph::Resolve(const UBlueprint* Blueprint, const FCognitiveComplexityCalculator& Calculator)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCallGraph::Resolve);
+
+	using namespace CognitiveComplexityCallGraph;
+
+	check(IsInGameThread());
+
+	CallSites.Reset();
+
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	TArray<const UEdGraph*, TInlineAllocator<16>> Roots;
+	GetRoots(Blueprint, Roots);
+
+	WalkCallees(Roots, this, [this](const UEdGraphNode* Node, const UEdGraph* Callee, bool bRecursive)
+	{
+		const FObjectKey CalleeKey(Callee);
+		Callers.AddUnique(CalleeKey, FObjectKey(Node->GetGraph()));
+
+		if (bRecursive)
+		{
+			// Also forgets the site if a root graph recorded it before the cycle was found, and
+			// remembers it, so the caller scores the same whether it is reached as a root or a callee.
+			RecursiveCallSites.Add(FObjectKey(Node), FObjectKey(Node->GetGraph()));
+			CallSites.Remove(Node);
+			UE_LOG(LogBpCognitiveComplexity, Verbose, TEXT("Recursive call to '%s' counted as a plain call."), *Callee->GetPathName());
+			return;
+		}
+
+		CallSites.Add(Node, CalleeKey);
+	},
+	[this, &Calculator](const UEdGraph* Callee)
+	{
+		// Every callee of this graph is scored or part of a cycle through it; score it now.
+		const UEdGraphNode* Entry = FindCalleeEntry(Callee);
+		CalleeScores.Add(FObjectKey(Callee), Entry ? Calculator.Calculate(*Entry).RawScore : 0.0f);
+	});
+}
+
+void FCognitiveComplexityCallGraph::WalkCallees(TConstArrayView<const UEdGraph*> Roots, const FCognitiveComplexityCallGraph* Memoized, TFunctionRef<void(const UEdGraphNode* Node, const UEdGraph* Callee, bool bRecursive)> OnCallSite, TFunctionRef<void(const UEdGraph* Callee)> OnFinished)
+{
+	// Depth-first over callee graphs, finishing each once all of its own callees are finished.
+	TSet<FObjectKey> InProgress;
+	TSet<FObjectKey> Finished;
+	TSet<const UEdGraphNode*> Recursive;
+	TArray<TPair<const UEdGraph*, int32>> Stack;
+
+	auto VisitNode = [Memoized, &OnCallSite, &InProgress, &Finished, &Recursive, &Stack](const UEdGraphNode* Node)
+	{
+		const UEdGraph* Callee = GetCallee(Node);
+		if (Callee == nullptr || Recursive.Contains(Node) || (Memoized != nullptr && Memoized->RecursiveCallSites.Contains(FObjectKey(Node))))
+		{
+			return;
+		}
+
+		const FObjectKey CalleeKey(Callee);
+		if (InProgress.Contains(CalleeKey))
+		{
+			Recursive.Add(Node);
+			OnCallSite(Node, Callee, /*bRecursive*/true);
+			return;
+		}
+
+		OnCallSite(Node, Callee, /*bRecursive*/false);
+		if (!Finished.Contains(CalleeKey) && (Memoized == nullptr || !Memoized->CalleeScores.Contains(CalleeKey)))
+		{
+			InProgress.Add(CalleeKey);
+			Stack.Emplace(Callee, 0);
+		}
+	};
+
+	for (const UEdGraph* Root : Roots)
+	{
+		if (Root == nullptr)
+		{
+			continue;
+		}
+
+		for (const UEdGraphNode* RootNode : Root->Nodes)
+		{
+			VisitNode(RootNode);
+
+			while (Stack.Num() > 0)
+			{
+				const UEdGraph* Callee = Stack.Last().Key;
+				const int32 NodeIndex = Stack.Last().Value++;
+
+				if (Callee->Nodes.IsValidIndex(NodeIndex))
+				{
+					VisitNode(Callee->Nodes[NodeIndex]);
+					continue;
+				}
+
+				const FObjectKey CalleeKey(Callee);
+				InProgress.Remove(CalleeKey);
+				Finished.Add(CalleeKey);
+				Stack.Pop(EAllowShrinking::No);
+				OnFinished(Callee);
+			}
+		}
+	}
+}
+
+float FCognitiveComplexityCallGraph::GetCallSiteScore(const UEdGraphNode* Node) const
+{
+	const FObjectKey* CalleeKey = CallSites.Find(Node);
+	if (CalleeKey == nullptr)
+	{
+		return 0.0f;
+	}
+
+	const float* Score = CalleeScores.Find(*CalleeKey);
+	return Score ? *Score : 0.0f;
+}
+
+void FCognitiveComplexityCallGraph::CaptureCallees(TConstArrayView<const UEdGraph*> Graphs, const FCognitiveComplexityCallGraph* Memoized, FCognitiveComplexitySnapshot& Snapshot)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCallGraph::CaptureCallees);
+
+	using namespace CognitiveComplexityCallGraph;
+
+	check(IsInGameThread());
+
+	FCognitiveComplexityResolvedCallees& Resolved = Snapshot.ResolvedCallees;
+	Resolved.CallGraphGeneration = Memoized ? Memoized->Generation : 0;
+
+	// Which call closes a recursion depends on the order the callees are walked in, so walk them
+	// from every graph of the owning Blueprint like Resolve does, then from any graph it skips.
+	TArray<const UEdGraph*, TInlineAllocator<16>> Roots;
+	const UEdGraph* const* FirstGraph = Graphs.FindByPredicate([](const UEdGraph* Graph) { return Graph != nullptr; });
+	if (const UBlueprint* Blueprint = FirstGraph ? (*FirstGraph)->GetTypedOuter<UBlueprint>() : nullptr)
+	{
+		GetRoots(Blueprint, Roots);
+	}
+	for (const UEdGraph* Graph : Graphs)
+	{
+		Roots.AddUnique(Graph);
+	}
+
+	TSet<const UEdGraphNode*> RecursiveNodes;
+	WalkCallees(Roots, Memoized, [&RecursiveNodes, &Resolved](const UEdGraphNode* Node, const UEdGraph* Callee, bool bRecursive)
+	{
+		if (bRecursive)
+		{
+			RecursiveNodes.Add(Node);
+			Resolved.RecursiveCallSites.Emplace(FObjectKey(Node), FObjectKey(Node->GetGraph()));
+		}
+	},
+	[](const UEdGraph* Callee)
+	{
+	});
+
+	TArray<const UEdGraph*> Callees;
+	TMap<const UEdGraph*, int32> CalleeIndices;
+
+	// Returns the index of the captured callee a node calls, or INDEX_NONE with its memoized
+	// score in OutScore, which stays 0 for nodes that call nothing or close a recursion.
+	auto VisitCallSite = [Memoized, &RecursiveNodes, &Callees, &CalleeIndices, &Resolved](const UEdGraphNode* Node, float& OutScore) -> int32
+	{
+		OutScore = 0.0f;
+
+		const UEdGraph* Callee = GetCallee(Node);
+		if (Callee == nullptr || (Memoized != nullptr && Memoized->RecursiveCallSites.Contains(FObjectKey(Node))))
+		{
+			return INDEX_NONE;
+		}
+
+		const FObjectKey CalleeKey(Callee);
+		Resolved.Callers.AddUnique(TPair<FObjectKey, FObjectKey>(CalleeKey, FObjectKey(Node->GetGraph())));
+
+		if (RecursiveNodes.Contains(Node))
+		{
+			return INDEX_NONE;
+		}
+
+		if (const float* Score = Memoized ? Memoized->CalleeScores.Find(CalleeKey) : nullptr)
+		{
+			OutScore = *Score;
+			return INDEX_NONE;
+		}
+
+		if (const int32* Index = CalleeIndices.Find(Callee))
+		{
+			return *Index;
+		}
+
+		const int32 Index = Callees.Add(Callee);
+		CalleeIndices.Add(Callee, Index);
+		Resolved.Callees.Add(CalleeKey);
+		return Index;
+	};
+
+	// Same numbering as FCognitiveComplexityFlatGraph::Build.
+	int32 NodeIndex = 0;
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (Graph == nullptr)
+		{
+			continue;
+		}
+
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node == nullptr)
+			{
+				continue;
+			}
+
+			float Score = 0.0f;
+			const int32 Callee = VisitCallSite(Node, Score);
+			if (Callee != INDEX_NONE)
+			{
+				Snapshot.PendingCallSites.Add({ NodeIndex, Callee });
+			}
+			Snapshot.Graph.CallSiteWeights[NodeIndex++] = Score;
+		}
+	}
+
+	check(NodeIndex == Snapshot.Graph.Num());
+
+	if (Callees.Num() == 0)
+	{
+		return;
+	}
+
+	// The captured callees grow as their own call sites are found, in the order they are flattened.
+	TArray<TPair<int32, float>> MemoizedCallSites;
+	int32 CalleeNodeIndex = 0;
+	for (int32 CalleeIndex = 0; CalleeIndex < Callees.Num(); ++CalleeIndex)
+	{
+		const UEdGraph* Callee = Callees[CalleeIndex];
+		const UEdGraphNode* Entry = FindCalleeEntry(Callee);
+
+		Snapshot.CalleeEntries.Add(INDEX_NONE);
+		Snapshot.CalleeCallSiteOffsets.Add(Snapshot.CalleeCallSites.Num());
+
+		for (const UEdGraphNode* Node : Callee->Nodes)
+		{
+			if (Node == nullptr)
+			{
+				continue;
+			}
+
+			if (Node == Entry)
+			{
+				Snapshot.CalleeEntries[CalleeIndex] = CalleeNodeIndex;
+			}
+
+			float Score = 0.0f;
+			const int32 Target = VisitCallSite(Node, Score);
+			if (Target != INDEX_NONE)
+			{
+				Snapshot.CalleeCallSites.Add({ CalleeNodeIndex, Target });
+			}
+			else if (Score != 0.0f)
+			{
+				MemoizedCallSites.Emplace(CalleeNodeIndex, Score);
+			}
+			++CalleeNodeIndex;
+		}
+	}
+
+	Snapshot.CalleeCallSiteOffsets.Add(Snapshot.CalleeCallSites.Num());
+
+	Snapshot.CalleeGraph = FCognitiveComplexityFlatGraph::Build(Callees);
+	check(Snapshot.CalleeGraph.Num() == CalleeNodeIndex);
+
+	for (const TPair<int32, float>& CallSite : MemoizedCallSites)
+	{
+		Snapshot.CalleeGraph.CallSiteWeights[CallSite.Key] = CallSite.Value;
+	}
+}
+
+void FCognitiveComplexityCallGraph::Adopt(const FCognitiveComplexityResolvedCallees& Resolved)
+{
+	check(IsInGameThread());
+
+	// Anything forgotten since the capture may be baked into the resolved scores.
+	if (Resolved.CallGraphGeneration != Generation || Resolved.Scores.Num() != Resolved.Callees.Num())
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < Resolved.Callees.Num(); ++Index)
+	{
+		CalleeScores.FindOrAdd(Resolved.Callees[Index], Resolved.Scores[Index]);
+	}
+
+	for (const TPair<FObjectKey, FObjectKey>& Caller : Resolved.Callers)
+	{
+		Callers.AddUnique(Caller.Key, Caller.Value);
+	}
+
+	for (const TPair<FObjectKey, FObjectKey>& CallSite : Resolved.RecursiveCallSites)
+	{
+		RecursiveCallSites.Add(CallSite.Key, CallSite.Value);
+	}
+}
+
+const UEdGraph* FCognitiveComplexityCallGraph::GetCallee(const UEdGraphNode* Node)
+{
+	if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+	{
+		// Resolves functions declared by this Blueprint or any Blueprint parent class; native calls have no graph.
+		const UEdGraphNode* CalleeEntry = nullptr;
+		return CallNode->GetFunctionGraph(CalleeEntry);
+	}
+
+	if (const UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
+	{
+		return MacroNode->GetMacroGraph();
+	}
+
+	return nullptr;
+}
+
+TArray<FName> FCognitiveComplexityCallGraph::CollectCalleePackages(TConstArrayView<const UEdGraph*> Graphs)
+{
+	TSet<FName> OwnPackages;
+	TSet<const UEdGraph*> Seen;
+	TArray<const UEdGraph*, TInlineAllocator<16>> Pending;
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (Graph != nullptr)
+		{
+			OwnPackages.Add(Graph->GetPackage()->GetFName());
+			Seen.Add(Graph);
+			Pending.Add(Graph);
+		}
+	}
+
+	TArray<FName> Packages;
+	while (Pending.Num() > 0)
+	{
+		const UEdGraph* Graph = Pending.Pop(EAllowShrinking::No);
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			const UEdGraph* Callee = GetCallee(Node);
+			if (Callee == nullptr)
+			{
+				continue;
+			}
+
+			bool bAlreadySeen = false;
+			Seen.Add(Callee, &bAlreadySeen);
+			if (bAlreadySeen)
+			{
+				continue;
+			}
+
+			Pending.Add(Callee);
+
+			const FName Package = Callee->GetPackage()->GetFName();
+			if (!OwnPackages.Contains(Package))
+			{
+				Packages.AddUnique(Package);
+			}
+		}
+	}
+
+	return Packages;
+}
+
+void FCognitiveComplexityCallGraph::Invalidate(const UEdGraph* Graph)
+{
+	// Also when nothing is memoized for the graph yet: a snapshot may be resolving its score.
+	++Generation;
+
+	if (Graph == nullptr)
+	{
+		return;
+	}
+
+	// Callers up the chain baked the graph's old score into theirs. A capture may have recorded
+	// recursive call sites in the graph without memoizing its score, so those go either way.
+	TSet<FObjectKey> Forgotten;
+	TArray<FObjectKey, TInlineAllocator<16>> Pending;
+	if (CalleeScores.Contains(FObjectKey(Graph)))
+	{
+		Pending.Add(FObjectKey(Graph));
+	}
+	else
+	{
+		Forgotten.Add(FObjectKey(Graph));
+	}
+
+	while (Pending.Num() > 0)
+	{
+		const FObjectKey Key = Pending.Pop(EAllowShrinking::No);
+		bool bAlreadyForgotten = false;
+		Forgotten.Add(Key, &bAlreadyForgotten);
+		if (bAlreadyForgotten)
+		{
+			continue;
+		}
+
+		CalleeScores.Remove(Key);
+		Callers.MultiFind(Key, Pending);
+	}
+
+	// Recursion is found again when the forgotten graphs are resolved next.
+	for (auto It = RecursiveCallSites.CreateIterator(); It; ++It)
+	{
+		if (Forgotten.Contains(It.Value()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FCognitiveComplexityCallGraph::Reset()
+{
+	++Generation;
+	CalleeScores.Reset();
+	Callers.Reset();
+	RecursiveCallSites.Reset();
+	CallSites.Reset();
+}
@@ -0,0 +1,118 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class FCognitiveComplexityCalculator;
+struct FCognitiveComplexitySnapshot;
+
+/**
+ * Callee scores a snapshot resolved off the game thread, handed back so the call graph the
+ * snapshot was captured against can memoize them.
+ */
+struct FCognitiveComplexityResolvedCallees
+{
+	/** FCognitiveComplexityCallGraph::GetGeneration at capture. */
+	uint32 CallGraphGeneration = 0;
+
+	/** Captured callee graphs and, once resolved, their scores in the same order. */
+	TArray<FObjectKey> Callees;
+	TArray<float> Scores;
+
+	/** Every (callee, calling graph) pair the capture found. */
+	TArray<TPair<FObjectKey, FObjectKey>> Callers;
+
+	/** Call sites the capture found closing a recursion, with the graph they are in. */
+	TArray<TPair<FObjectKey, FObjectKey>> RecursiveCallSites;
+};
+
+/**
+ * Scores of the functions and macros a Blueprint calls, used when calls are weighted by their callee.
+ *
+ * Resolve walks the call graph of a Blueprint once: local functions, parent-class functions and
+ * macro graphs reachable from its call sites are scored callees first (post-order), and every
+ * score is memoized per callee graph, so a function costs one walk per scan no matter how many
+ * call sites or Blueprints reach it. A call back into a function that is still being resolved
+ * (recursion) counts as a plain call.
+ *
+ * Resolve must run on the game thread; once it returned, lookups are read-only and safe from the
+ * scoring worker threads. Snapshots only capture callee graphs and score them on a worker thread,
+ * so their scores are memoized through Adopt once they land. Capture walks the callees in the same
+ * order as Resolve, so both count the same calls as recursive.
+ */
+class FCognitiveComplexityCallGraph
+{
+public:
+	/**
+	 * Scores every callee reachable from the Blueprint's event and function graphs that is not
+	 * memoized yet, and records the Blueprint's call sites. Calculator must use this call graph.
+	 */
+	void Resolve(const UBlueprint* Blueprint, const FCognitiveComplexityCalculator& Calculator);
+
+	/** Score of the function or macro a call site calls, or 0 if it was not recorded by the last Resolve. */
+	float GetCallSiteScore(const UEdGraphNode* Node) const;
+
+	/**
+	 * Copies the callee scores of the call sites in Graphs into Snapshot.Graph, which must have been
+	 * flattened from Graphs. Scores memoized in Memoized, if given, are copied directly; every other
+	 * callee reachable from the call sites is flattened into Snapshot.CalleeGraph to be scored by
+	 * FCognitiveComplexityCalculator::ResolveCallees. Calls Resolve would count as recursive stay
+	 * plain calls. Must run on the game thread, but scores nothing.
+	 */
+	static void CaptureCallees(TConstArrayView<const UEdGraph*> Graphs, const FCognitiveComplexityCallGraph* Memoized, FCognitiveComplexitySnapshot& Snapshot);
+
+	/** Function or macro graph a node calls, if it is a call to a Blueprint function or a macro instance. */
+	static const UEdGraph* GetCallee(const UEdGraphNode* Node);
+
+	/**
+	 * Packages of every function and macro graph reachable through the call sites of Graphs,
+	 * excluding the packages of Graphs themselves. Scores weighted by callee depend on these.
+	 */
+	static TArray<FName> CollectCalleePackages(TConstArrayView<const UEdGraph*> Graphs);
+
+	/**
+	 * Memoizes the callee scores and recursive call sites a snapshot resolved, unless the call graph
+	 * forgot any score since the snapshot was captured, in which case they may already be stale.
+	 */
+	void Adopt(const FCognitiveComplexityResolvedCallees& Resolved);
+
+	/** Bumped by every Invalidate and Reset. */
+	uint32 GetGeneration() const { return Generation; }
+
+	/** Number of callee graphs scored so far. */
+	int32 GetNumResolved() const { return CalleeScores.Num(); }
+
+	/** Forgets the memoized score of an edited graph and of every callee whose score includes it. */
+	void Invalidate(const UEdGraph* Graph);
+
+	/** Forgets every memoized callee score, e.g. after a settings change. */
+	void Reset();
+
+private:
+	/**
+	 * Walks the callees reachable from the call sites of Roots depth-first, skipping the callees
+	 * Memoized has a score for. OnCallSite sees every call site outside a known recursion, and
+	 * whether it calls a callee still in progress. OnFinished sees every callee once all of its
+	 * own callees finished. Resolve and CaptureCallees share it, so they agree on recursion.
+	 */
+	static void WalkCallees(TConstArrayView<const UEdGraph*> Roots, const FCognitiveComplexityCallGraph* Memoized, TFunctionRef<void(const UEdGraphNode* Node, const UEdGraph* Callee, bool bRecursive)> OnCallSite, TFunctionRef<void(const UEdGraph* Callee)> OnFinished);
+
+	/** Raw score of each resolved callee graph, including its own entry weight. */
+	TMap<FObjectKey, float> CalleeScores;
+
+	/** Graphs calling each callee graph, so an edit only forgets the scores that include it. */
+	TMultiMap<FObjectKey, FObjectKey> Callers;
+
+	/** Call sites that close a recursion cycle, with the graph they are in. They count as plain calls. */
+	TMap<FObjectKey, FObjectKey> RecursiveCallSites;
+
+	/** Callee of each call site seen by the last Resolve. Only valid until the next one. */
+	TMap<const UEdGraphNode*, FObjectKey> CallSites;
+
+	uint32 Generation = 0;
+};
@@ -1,8 +1,10 @@
 #include "CognitiveComplexityDashboard.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "BpCognitiveComplexity.h"
 #include "BpCognitiveComplexitySettings.h"
-#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityScanner.h"
+#include "CognitiveComplexityStats.h"
 #include "CognitiveComplexityTypes.h"
 #include "EdGraph/EdGraph.h"
 #include "Editor.h"
@@ -12,16 +14,126 @@
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Styling/AppStyle.h"
 #include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Input/SSpinBox.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SExpandableArea.h"
 #include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Layout/SWrapBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
 
 
+DEFINE_STAT(STAT_BpCognitiveComplexity_DashboardRefresh);
+
 static const FName DashboardTabId(TEXT("BpCognitiveComplexity_Dashboard"));
 
+static const FName ColumnBlueprint(TEXT("Blueprint"));
+static const FName ColumnPath(TEXT("Path"));
+static const FName ColumnEntry(TEXT("Entry"));
+static const FName ColumnPercent(TEXT("Percent"));
+static const FName ColumnRawScore(TEXT("RawScore"));
+
+/** Structural metric columns, in display order. */
+struct FMetricColumn
+{
+	FName ColumnId;
+	int32 FCognitiveComplexityMetrics::* Field;
+};
+
+static const FMetricColumn MetricColumns[] =
+{
+	{ TEXT("Cyclomatic"), &FCognitiveComplexityMetrics::Cyclomatic },
+	{ TEXT("NodeCount"), &FCognitiveComplexityMetrics::NodeCount },
+	{ TEXT("MaxNesting"), &FCognitiveComplexityMetrics::MaxNesting },
+	{ TEXT("MaxFanOut"), &FCognitiveComplexityMetrics::MaxFanOut },
+	{ TEXT("LatentCount"), &FCognitiveComplexityMetrics::LatentCount },
+};
+
+static constexpr int32 NumMetricColumns = UE_ARRAY_COUNT(MetricColumns);
+
+static int32 FindMetricColumn(const FName ColumnId)
+{
+	for (int32 Index = 0; Index < NumMetricColumns; ++Index)
+	{
+		if (MetricColumns[Index].ColumnId == ColumnId)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+static FText GetMetricColumnLabel(int32 MetricIndex)
+{
+	static const FText Labels[NumMetricColumns] =
+	{
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnCyclomatic", "Cyclomatic"),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnNodeCount", "Nodes"),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnMaxNesting", "Nesting"),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnMaxFanOut", "Fan-Out"),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnLatentCount", "Latent"),
+	};
+	return Labels[MetricIndex];
+}
+
+static FText GetMetricColumnTooltip(int32 MetricIndex)
+{
+	static const FText Tooltips[NumMetricColumns] =
+	{
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnCyclomaticTooltip", "Cyclomatic complexity of the exec graph reached from the entry (exec links - exec nodes + 2)."),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnNodeCountTooltip", "Nodes reached from the entry, including scored pure nodes when the data-flow pass is on."),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnMaxNestingTooltip", "Deepest nesting level reached."),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnMaxFanOutTooltip", "Most exec links leaving a single node."),
+		NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnLatentCountTooltip", "Latent nodes reached from the entry."),
+	};
+	return Tooltips[MetricIndex];
+}
+
+/** Number of weights the what-if panel edits: the node categories, nesting, the two data-flow weights and the percent scale. */
+static constexpr int32 NumWhatIfWeights = FCognitiveComplexityWeights::NumCategories + 4;
+
+static float& GetWhatIfWeight(FCognitiveComplexityWeights& Weights, int32 WeightIndex)
+{
+	if (WeightIndex < FCognitiveComplexityWeights::NumCategories)
+	{
+		return Weights.Categories[WeightIndex];
+	}
+
+	switch (WeightIndex - FCognitiveComplexityWeights::NumCategories)
+	{
+	case 0: return Weights.NestingPenalty;
+	case 1: return Weights.DataFlowMath;
+	case 2: return Weights.DataFlowCall;
+	default: return Weights.PercentScale;
+	}
+}
+
+static FText GetWhatIfWeightLabel(int32 WeightIndex)
+{
+	static const FText Labels[NumWhatIfWeights] =
+	{
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfEntry", "Entry"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfBranch", "Branch"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfSelect", "Select"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfLoop", "Loop"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfLatent", "Latent"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfFunctionCall", "Function call"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfMath", "Math"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfNesting", "Nesting"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfDataFlowMath", "Data-flow math"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfDataFlowCall", "Data-flow call"),
+		NSLOCTEXT("BpCognitiveComplexity", "WhatIfPercentScale", "Percent scale"),
+	};
+	return Labels[WeightIndex];
+}
+
 struct FCognitiveComplexityEntryRow
 {
 	FString BlueprintName;
@@ -30,10 +142,79 @@ struct FCognitiveComplexityEntryRow
 	FString EntryDisplayName;
 	float RawScore = 0.0f;
 	float Percent = 0.0f;
+
+	/** Lets the what-if weights re-score the row without a rescan. Rows read from asset tags have none. */
+	FCognitiveComplexityFeatures Features;
+	bool bHasFeatures = false;
+
+	/** Structural metrics. Rows read from asset tags have none and sort below every row that does. */
+	FCognitiveComplexityMetrics Metrics;
+	bool bHasMetrics = false;
+
+	/** Lower-cased "Blueprint Entry", so the text filter is a plain substring search. */
+	FString SearchText;
+
+	/** Lower-cased names, so sorting compares ordinally instead of folding case on every comparison. */
+	FString BlueprintSortKey;
+	FString PathSortKey;
+	FString EntrySortKey;
+
+	/** Index of the row in the dashboard's AllRows. */
+	int32 RowIndex = INDEX_NONE;
+
+	/** Display texts, built once when the row is created instead of every time it scrolls into view. */
+	FText BlueprintText;
+	FText PathText;
+	FText EntryText;
+	FText PercentText;
+	FText RawScoreText;
+	FText MetricTexts[NumMetricColumns];
 };
 
 typedef TSharedPtr<FCognitiveComplexityEntryRow> FCognitiveComplexityEntryRowPtr;
 
+class SCognitiveComplexityEntryRowWidget : public SMultiColumnTableRow<FCognitiveComplexityEntryRowPtr>
+{
+public:
+	SLATE_BEGIN_ARGS(SCognitiveComplexityEntryRowWidget)
+		{
+		}
+
+		SLATE_ARGUMENT(FCognitiveComplexityEntryRowPtr, Item)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		Item = InArgs._Item;
+		SMultiColumnTableRow<FCognitiveComplexityEntryRowPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		const int32 MetricIndex = FindMetricColumn(ColumnName);
+		if (ColumnName == ColumnPercent || ColumnName == ColumnRawScore || MetricIndex != INDEX_NONE)
+		{
+			return SNew(SBox)
+				.HAlign(HAlign_Right)
+				[
+					SNew(STextBlock)
+					.Text(MetricIndex != INDEX_NONE ? Item->MetricTexts[MetricIndex] : ColumnName == ColumnPercent ? Item->PercentText : Item->RawScoreText)
+				];
+		}
+
+		const FText& Text = ColumnName == ColumnBlueprint ? Item->BlueprintText
+			: ColumnName == ColumnPath ? Item->PathText
+			: Item->EntryText;
+
+		return SNew(STextBlock)
+			.Text(Text)
+			.ToolTipText(Text);
+	}
+
+private:
+	FCognitiveComplexityEntryRowPtr Item;
+};
+
 class SCognitiveComplexityDashboard : public SCompoundWidget
 {
 public:
@@ -45,10 +226,103 @@ public:
 
 	SCognitiveComplexityDashboard() = default;
 
+	virtual ~SCognitiveComplexityDashboard() override
+	{
+		CancelScan();
+	}
+
 	void Construct(const FArguments& InArgs)
 	{
 		ThresholdPercent = 60.0f;
 
+		if (const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get())
+		{
+			WhatIfWeights = Settings->GetWeights();
+		}
+
+		TSharedRef<SWrapBox> WhatIfSliders = SNew(SWrapBox)
+			.UseAllottedSize(true);
+
+		for (int32 WeightIndex = 0; WeightIndex < NumWhatIfWeights; ++WeightIndex)
+		{
+			WhatIfSliders->AddSlot()
+			.Padding(0.0f, 2.0f, 12.0f, 2.0f)
+			[
+				SNew(SHorizontalBox)
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 4.0f, 0.0f)
+				[
+					SNew(STextBlock)
+					.Text(GetWhatIfWeightLabel(WeightIndex))
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SBox)
+					.WidthOverride(64.0f)
+					[
+						SNew(SSpinBox<int32>)
+						.MinValue(WeightIndex == NumWhatIfWeights - 1 ? 1 : 0)
+						.MaxSliderValue(WeightIndex == NumWhatIfWeights - 1 ? 500 : 20)
+						.Value(this, &SCognitiveComplexityDashboard::GetWhatIfWeightValue, WeightIndex)
+						.OnValueChanged(this, &SCognitiveComplexityDashboard::OnWhatIfWeightChanged, WeightIndex)
+					]
+				]
+			];
+		}
+
+		// Score columns first, then one column per structural metric.
+		TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow)
+
+		+ SHeaderRow::Column(ColumnBlueprint)
+		.DefaultLabel(NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnBlueprint", "Blueprint"))
+		.FillWidth(0.20f)
+		.SortMode(this, &SCognitiveComplexityDashboard::GetColumnSortMode, ColumnBlueprint)
+		.OnSort(this, &SCognitiveComplexityDashboard::OnSortColumn)
+
+		+ SHeaderRow::Column(ColumnPath)
+		.DefaultLabel(NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnPath", "Path"))
+		.FillWidth(0.20f)
+		.SortMode(this, &SCognitiveComplexityDashboard::GetColumnSortMode, ColumnPath)
+		.OnSort(this, &SCognitiveComplexityDashboard::OnSortColumn)
+
+		+ SHeaderRow::Column(ColumnEntry)
+		.DefaultLabel(NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnEntry", "Entry"))
+		.FillWidth(0.20f)
+		.SortMode(this, &SCognitiveComplexityDashboard::GetColumnSortMode, ColumnEntry)
+		.OnSort(this, &SCognitiveComplexityDashboard::OnSortColumn)
+
+		+ SHeaderRow::Column(ColumnPercent)
+		.DefaultLabel(NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnPercent", "Complexity %"))
+		.FillWidth(0.08f)
+		.HAlignHeader(HAlign_Right)
+		.SortMode(this, &SCognitiveComplexityDashboard::GetColumnSortMode, ColumnPercent)
+		.OnSort(this, &SCognitiveComplexityDashboard::OnSortColumn)
+
+		+ SHeaderRow::Column(ColumnRawScore)
+		.DefaultLabel(NSLOCTEXT("BpCognitiveComplexity", "DashboardColumnRawScore", "Raw Score"))
+		.FillWidth(0.08f)
+		.HAlignHeader(HAlign_Right)
+		.SortMode(this, &SCognitiveComplexityDashboard::GetColumnSortMode, ColumnRawScore)
+		.OnSort(this, &SCognitiveComplexityDashboard::OnSortColumn);
+
+		for (int32 MetricIndex = 0; MetricIndex < NumMetricColumns; ++MetricIndex)
+		{
+			const FName ColumnId = MetricColumns[MetricIndex].ColumnId;
+			HeaderRow->AddColumn(SHeaderRow::Column(ColumnId)
+				.DefaultLabel(GetMetricColumnLabel(MetricIndex))
+				.DefaultTooltip(GetMetricColumnTooltip(MetricIndex))
+				.FillWidth(0.048f)
+				.HAlignHeader(HAlign_Right)
+				.SortMode(this, &SCognitiveComplexityDashboard::GetColumnSortMode, ColumnId)
+				.OnSort(this, &SCognitiveComplexityDashboard::OnSortColumn));
+		}
+
 		ChildSlot
 		[
 			SNew(SVerticalBox)
@@ -84,11 +358,155 @@ public:
 				+SHorizontalBox::Slot()
 				.AutoWidth()
 				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
 				[
 					SNew(SButton)
 					.OnClicked(this, &SCognitiveComplexityDashboard::OnRescanClicked)
 					.Text(NSLOCTEXT("BpCognitiveComplexity", "DashboardRescan", "Rescan Blueprints"))
 				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SButton)
+					.OnClicked(this, &SCognitiveComplexityDashboard::OnLoadUnscoredClicked)
+					.IsEnabled(this, &SCognitiveComplexityDashboard::HasUnscored)
+					.Text(NSLOCTEXT("BpCognitiveComplexity", "DashboardLoadUnscored", "Load Unscored Blueprints"))
+					.ToolTipText(NSLOCTEXT("BpCognitiveComplexity", "DashboardLoadUnscoredTooltip", "Rescan, loading Blueprints that have no saved complexity score yet."))
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.OnClicked(this, &SCognitiveComplexityDashboard::OnCancelClicked)
+					.IsEnabled(this, &SCognitiveComplexityDashboard::IsScanning)
+					.Text(NSLOCTEXT("BpCognitiveComplexity", "DashboardCancelScan", "Cancel"))
+				]
+			]
+
+			// Filters
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4.0f)
+			[
+				SNew(SHorizontalBox)
+
+				+SHorizontalBox::Slot()
+				.FillWidth(0.6f)
+				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SSearchBox)
+					.HintText(NSLOCTEXT("BpCognitiveComplexity", "DashboardSearchHint", "Filter by Blueprint or entry name"))
+					.OnTextChanged(this, &SCognitiveComplexityDashboard::OnSearchTextChanged)
+				]
+
+				+SHorizontalBox::Slot()
+				.FillWidth(0.4f)
+				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SEditableTextBox)
+					.HintText(NSLOCTEXT("BpCognitiveComplexity", "DashboardPathHint", "Path prefix, e.g. /Game/Characters"))
+					.OnTextChanged(this, &SCognitiveComplexityDashboard::OnPathFilterChanged)
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(this, &SCognitiveComplexityDashboard::GetRowCountText)
+				]
+			]
+
+			// What-if weights
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4.0f)
+			[
+				SNew(SExpandableArea)
+				.InitiallyCollapsed(true)
+				.AreaTitle(NSLOCTEXT("BpCognitiveComplexity", "WhatIfTitle", "What-If Weights"))
+				.BodyContent()
+				[
+					SNew(SVerticalBox)
+
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					[
+						WhatIfSliders
+					]
+
+					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+					[
+						SNew(SHorizontalBox)
+
+						+SHorizontalBox::Slot()
+						.AutoWidth()
+						.VAlign(VAlign_Center)
+						.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+						[
+							SNew(SButton)
+							.OnClicked(this, &SCognitiveComplexityDashboard::OnWhatIfResetClicked)
+							.IsEnabled(this, &SCognitiveComplexityDashboard::IsWhatIfActive)
+							.Text(NSLOCTEXT("BpCognitiveComplexity", "WhatIfReset", "Reset"))
+							.ToolTipText(NSLOCTEXT("BpCognitiveComplexity", "WhatIfResetTooltip", "Go back to the weights from the plugin settings."))
+						]
+
+						+SHorizontalBox::Slot()
+						.AutoWidth()
+						.VAlign(VAlign_Center)
+						.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+						[
+							SNew(SButton)
+							.OnClicked(this, &SCognitiveComplexityDashboard::OnWhatIfApplyClicked)
+							.IsEnabled(this, &SCognitiveComplexityDashboard::IsWhatIfActive)
+							.Text(NSLOCTEXT("BpCognitiveComplexity", "WhatIfApply", "Apply to Settings"))
+							.ToolTipText(NSLOCTEXT("BpCognitiveComplexity", "WhatIfApplyTooltip", "Save these weights to the plugin settings."))
+						]
+
+						+SHorizontalBox::Slot()
+						.FillWidth(1.0f)
+						.VAlign(VAlign_Center)
+						[
+							SNew(STextBlock)
+							.Text(this, &SCognitiveComplexityDashboard::GetWhatIfStatusText)
+							.AutoWrapText(true)
+						]
+					]
+				]
+			]
+
+			// Scan progress
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(4.0f)
+			[
+				SNew(SHorizontalBox)
+
+				+SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SProgressBar)
+					.Percent(this, &SCognitiveComplexityDashboard::GetScanProgress)
+				]
+
+				+SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(this, &SCognitiveComplexityDashboard::GetScanStatusText)
+				]
 			]
 
 			// Results list
@@ -101,6 +519,7 @@ public:
 				.SelectionMode(ESelectionMode::Single)
 				.OnGenerateRow(this, &SCognitiveComplexityDashboard::OnGenerateRow)
 				.OnMouseButtonDoubleClick(this, &SCognitiveComplexityDashboard::OnItemDoubleClicked)
+				.HeaderRow(HeaderRow)
 			]
 		];
 
@@ -115,8 +534,236 @@ private:
 
 	void OnThresholdChanged(float NewValue)
 	{
+		// Filtering only; the scanned rows stay as they are.
 		ThresholdPercent = NewValue;
-		Refresh();
+		ApplyFilters();
+	}
+
+	void OnSearchTextChanged(const FText& NewText)
+	{
+		SearchText = NewText.ToString().ToLower();
+		ApplyFilters();
+	}
+
+	void OnPathFilterChanged(const FText& NewText)
+	{
+		PathFilter = NewText.ToString();
+		ApplyFilters();
+	}
+
+	FText GetRowCountText() const
+	{
+		return FText::Format(NSLOCTEXT("BpCognitiveComplexity", "DashboardRowCount", "Showing {0} of {1} entries"),
+			FText::AsNumber(Rows.Num()), FText::AsNumber(AllRows.Num()));
+	}
+
+	EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const
+	{
+		return ColumnId == SortColumn ? SortMode : EColumnSortMode::None;
+	}
+
+	void OnSortColumn(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode)
+	{
+		SortColumn = ColumnId;
+		SortMode = NewSortMode;
+
+		// The only full sort: the whole order is rebuilt once per header click.
+		SortAllRows();
+		ApplyFilters();
+	}
+
+	void SortAllRows()
+	{
+		// Rows still waiting for FlushPendingRows are sorted in with the rest.
+		PendingRowIndices.Reset();
+
+		SortedOrder.Reset(AllRows.Num());
+		for (int32 Index = 0; Index < AllRows.Num(); ++Index)
+		{
+			SortedOrder.Add(Index);
+		}
+		SortedOrder.Sort([this](int32 A, int32 B) { return IsRowLess(A, B); });
+	}
+
+	int32 GetWhatIfWeightValue(int32 WeightIndex) const
+	{
+		FCognitiveComplexityWeights Weights = WhatIfWeights;
+		return FMath::RoundToInt(GetWhatIfWeight(Weights, WeightIndex));
+	}
+
+	void OnWhatIfWeightChanged(int32 NewValue, int32 WeightIndex)
+	{
+		float& Weight = GetWhatIfWeight(WhatIfWeights, WeightIndex);
+		if (Weight == static_cast<float>(NewValue))
+		{
+			return;
+		}
+
+		Weight = static_cast<float>(NewValue);
+		bWhatIfActive = true;
+		ApplyWhatIfWeights();
+	}
+
+	bool IsWhatIfActive() const
+	{
+		return bWhatIfActive;
+	}
+
+	FReply OnWhatIfResetClicked()
+	{
+		if (const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get())
+		{
+			WhatIfWeights = Settings->GetWeights();
+		}
+
+		bWhatIfActive = false;
+		ApplyWhatIfWeights();
+		return FReply::Handled();
+	}
+
+	FReply OnWhatIfApplyClicked()
+	{
+		UBpCognitiveComplexitySettings* Settings = GetMutableDefault<UBpCognitiveComplexitySettings>();
+		Settings->SetWeights(WhatIfWeights);
+		Settings->TryUpdateDefaultConfigFile();
+		UBpCognitiveComplexitySettings::OnSettingsChanged().Broadcast();
+
+		// The rows already show these weights; rows without features pick them up on the next scan.
+		bWhatIfActive = false;
+		return FReply::Handled();
+	}
+
+	FText GetWhatIfStatusText() const
+	{
+		if (NumRowsWithoutFeatures == 0)
+		{
+			return NSLOCTEXT("BpCognitiveComplexity", "WhatIfStatus", "Scores update while dragging; nothing is rescanned.");
+		}
+
+		return FText::Format(NSLOCTEXT("BpCognitiveComplexity", "WhatIfStatusPartial", "Scores update while dragging; nothing is rescanned. {0} entries read from saved asset tags keep their saved score."),
+			FText::AsNumber(NumRowsWithoutFeatures));
+	}
+
+	/** Scores a row from its features under the what-if weights, if it has any. */
+	void EvaluateRow(FCognitiveComplexityEntryRow& Row) const
+	{
+		if (!Row.bHasFeatures)
+		{
+			return;
+		}
+
+		const FCognitiveComplexityScore Score = Row.Features.Evaluate(WhatIfWeights);
+		Row.RawScore = Score.RawScore;
+		Row.Percent = Score.Percent;
+		Row.PercentText = FText::AsNumber(FMath::RoundToInt(Score.Percent));
+		Row.RawScoreText = FText::AsNumber(Score.RawScore);
+	}
+
+	/** Re-scores every row from its features, then re-sorts and re-filters. A dot product per row; no graph is walked. */
+	void ApplyWhatIfWeights()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SCognitiveComplexityDashboard::ApplyWhatIfWeights);
+
+		for (const FCognitiveComplexityEntryRowPtr& Row : AllRows)
+		{
+			EvaluateRow(*Row);
+		}
+
+		SortAllRows();
+		ApplyFilters();
+
+		// Row widgets copy their texts when generated, so the visible ones are rebuilt.
+		if (ListViewWidget.IsValid())
+		{
+			ListViewWidget->RebuildList();
+		}
+	}
+
+	/** Strict ordering of two rows under the current sort column and direction. Ties fall back to score, then names. */
+	bool IsRowLess(int32 IndexA, int32 IndexB) const
+	{
+		const FCognitiveComplexityEntryRow& A = *AllRows[IndexA];
+		const FCognitiveComplexityEntryRow& B = *AllRows[IndexB];
+
+		int32 Comparison = 0;
+		if (SortColumn == ColumnBlueprint)
+		{
+			Comparison = A.BlueprintSortKey.Compare(B.BlueprintSortKey, ESearchCase::CaseSensitive);
+		}
+		else if (SortColumn == ColumnPath)
+		{
+			Comparison = A.PathSortKey.Compare(B.PathSortKey, ESearchCase::CaseSensitive);
+		}
+		else if (SortColumn == ColumnEntry)
+		{
+			Comparison = A.EntrySortKey.Compare(B.EntrySortKey, ESearchCase::CaseSensitive);
+		}
+		else if (SortColumn == ColumnRawScore && A.RawScore != B.RawScore)
+		{
+			Comparison = A.RawScore < B.RawScore ? -1 : 1;
+		}
+		else if (const int32 MetricIndex = FindMetricColumn(SortColumn); MetricIndex != INDEX_NONE)
+		{
+			const int32 ValueA = A.bHasMetrics ? A.Metrics.*MetricColumns[MetricIndex].Field : -1;
+			const int32 ValueB = B.bHasMetrics ? B.Metrics.*MetricColumns[MetricIndex].Field : -1;
+			Comparison = ValueA == ValueB ? 0 : ValueA < ValueB ? -1 : 1;
+		}
+
+		if (Comparison == 0 && A.Percent != B.Percent)
+		{
+			Comparison = A.Percent < B.Percent ? -1 : 1;
+		}
+
+		if (Comparison != 0)
+		{
+			return SortMode == EColumnSortMode::Descending ? Comparison > 0 : Comparison < 0;
+		}
+
+		if (const int32 NameComparison = A.BlueprintSortKey.Compare(B.BlueprintSortKey, ESearchCase::CaseSensitive); NameComparison != 0)
+		{
+			return NameComparison < 0;
+		}
+
+		if (const int32 EntryComparison = A.EntrySortKey.Compare(B.EntrySortKey, ESearchCase::CaseSensitive); EntryComparison != 0)
+		{
+			return EntryComparison < 0;
+		}
+
+		return A.RowIndex < B.RowIndex;
+	}
+
+	bool PassesFilters(const FCognitiveComplexityEntryRow& Row) const
+	{
+		if (Row.Percent < ThresholdPercent)
+		{
+			return false;
+		}
+		if (!PathFilter.IsEmpty() && !Row.BlueprintPath.StartsWith(PathFilter, ESearchCase::IgnoreCase))
+		{
+			return false;
+		}
+		return SearchText.IsEmpty() || Row.SearchText.Contains(SearchText, ESearchCase::CaseSensitive);
+	}
+
+	/** Rebuilds the visible rows from the sorted order. Linear in the number of rows and never re-sorts. */
+	void ApplyFilters()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SCognitiveComplexityDashboard::ApplyFilters);
+
+		Rows.Reset();
+
+		for (const int32 Index : SortedOrder)
+		{
+			if (PassesFilters(*AllRows[Index]))
+			{
+				Rows.Add(AllRows[Index]);
+			}
+		}
+
+		if (ListViewWidget.IsValid())
+		{
+			ListViewWidget->RequestListRefresh();
+		}
 	}
 
 	FReply OnRescanClicked()
@@ -125,44 +772,74 @@ private:
 		return FReply::Handled();
 	}
 
-	TSharedRef<ITableRow> OnGenerateRow(FCognitiveComplexityEntryRowPtr InItem,
-	                                    const TSharedRef<STableViewBase>& OwnerTable) const
+	FReply OnLoadUnscoredClicked()
 	{
-		check(InItem.IsValid());
+		Refresh(/*bLoadUnscored*/true);
+		return FReply::Handled();
+	}
+
+	bool HasUnscored() const
+	{
+		return Scanner.IsValid() && !Scanner->IsRunning() && Scanner->GetNumUnscored() > 0;
+	}
 
-		const FText BlueprintText = FText::FromString(
-			FString::Printf(TEXT("%s (%s)"), *InItem->BlueprintName, *InItem->BlueprintPath));
-		const FText EntryText = FText::FromString(InItem->EntryDisplayName);
-		const FText PercentText = FText::AsNumber(FMath::RoundToInt(InItem->Percent));
+	FReply OnCancelClicked()
+	{
+		CancelScan();
+		return FReply::Handled();
+	}
 
-		return SNew(STableRow<FCognitiveComplexityEntryRowPtr>, OwnerTable)
-			[
-				SNew(SHorizontalBox)
+	bool IsScanning() const
+	{
+		return Scanner.IsValid() && Scanner->IsRunning();
+	}
 
-				+ SHorizontalBox::Slot()
-				.FillWidth(0.45f)
-				[
-					SNew(STextBlock)
-					.Text(BlueprintText)
-					.ToolTipText(BlueprintText)
-				]
+	TOptional<float> GetScanProgress() const
+	{
+		return Scanner.IsValid() ? Scanner->GetProgress() : 0.0f;
+	}
 
-				+ SHorizontalBox::Slot()
-				.FillWidth(0.35f)
-				[
-					SNew(STextBlock)
-					.Text(EntryText)
-					.ToolTipText(EntryText)
-				]
+	FText GetScanStatusText() const
+	{
+		if (!Scanner.IsValid())
+		{
+			return FText::GetEmpty();
+		}
 
-				+ SHorizontalBox::Slot()
-				.FillWidth(0.20f)
-				.HAlign(HAlign_Right)
-				[
-					SNew(STextBlock)
-					.Text(PercentText)
-				]
-			];
+		const FText Format = IsScanning()
+			? NSLOCTEXT("BpCognitiveComplexity", "DashboardScanning", "Scanning {0} / {1} Blueprints ({2} without loading), peak memory {3}")
+			: bScanCancelled
+				? NSLOCTEXT("BpCognitiveComplexity", "DashboardScanCancelled", "Cancelled after {0} / {1} Blueprints ({2} without loading), peak memory {3}")
+				: NSLOCTEXT("BpCognitiveComplexity", "DashboardScanDone", "Scanned {0} / {1} Blueprints ({2} without loading), peak memory {3}");
+
+		const FText Status = FText::Format(Format, FText::AsNumber(Scanner->GetNumCompleted()), FText::AsNumber(Scanner->GetNumTotal()),
+			FText::AsNumber(Scanner->GetNumCached()), FText::AsMemory(Scanner->GetPeakUsedPhysical()));
+
+		if (Scanner->GetNumUnscored() == 0)
+		{
+			return Status;
+		}
+
+		return FText::Format(NSLOCTEXT("BpCognitiveComplexity", "DashboardUnscored", "{0}; {1} unloaded Blueprints have no saved score"),
+			Status, FText::AsNumber(Scanner->GetNumUnscored()));
+	}
+
+	void CancelScan()
+	{
+		if (IsScanning())
+		{
+			Scanner->Cancel();
+			bScanCancelled = true;
+		}
+	}
+
+	TSharedRef<ITableRow> OnGenerateRow(FCognitiveComplexityEntryRowPtr InItem,
+	                                    const TSharedRef<STableViewBase>& OwnerTable) const
+	{
+		check(InItem.IsValid());
+
+		return SNew(SCognitiveComplexityEntryRowWidget, OwnerTable)
+			.Item(InItem);
 	}
 
 	void OnItemDoubleClicked(FCognitiveComplexityEntryRowPtr InItem)
@@ -242,17 +919,26 @@ private:
 		}
 	}
 
-	void Refresh()
+	void Refresh(bool bLoadUnscored = false)
 	{
+		SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_DashboardRefresh);
+
+		CancelScan();
+		Scanner.Reset();
+		bScanCancelled = false;
 		Rows.Reset();
+		AllRows.Reset();
+		SortedOrder.Reset();
+		PendingRowIndices.Reset();
+		NumRowsWithoutFeatures = 0;
 
-		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
-		if (!Settings)
+		if (ListViewWidget.IsValid())
+		{
+			ListViewWidget->RequestListRefresh();
+		}
+
+		if (!UBpCognitiveComplexitySettings::Get())
 		{
-			if (ListViewWidget.IsValid())
-			{
-				ListViewWidget->RequestListRefresh();
-			}
 			return;
 		}
 
@@ -262,78 +948,174 @@ private:
 		AssetRegistryModule.Get().
 		                    GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), BlueprintAssets, true);
 
-		const FCognitiveComplexityCalculator Calculator(*Settings);
-
-		for (const FAssetData& AssetData : BlueprintAssets)
+		// Only consider user/content Blueprints, skip engine/editor/plugin script assets.
+		BlueprintAssets.RemoveAll([](const FAssetData& AssetData)
 		{
-			// Only consider user/content Blueprints, skip engine/editor/plugin script assets.
-			const FString PackagePathString = AssetData.PackagePath.ToString();
-			if (!PackagePathString.StartsWith(TEXT("/Game")))
-			{
-				continue;
-			}
+			return !AssetData.PackagePath.ToString().StartsWith(TEXT("/Game"));
+		});
 
-			const UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-			if (!Blueprint)
-			{
-				continue;
-			}
+		// Loading and scoring happen over several frames; rows stream in as batches complete.
+		// Assets unchanged since they were last scored come straight from the on-disk result cache
+		// or from the complexity tags saved into the asset registry; only loaded Blueprints are
+		// scored unless the user explicitly asks for the unscored ones to be loaded.
+		Scanner = MakeShared<FCognitiveComplexityScanner>();
+		Scanner->SetResultCache(FBpCognitiveComplexityModule::Get().GetResultCache());
+		Scanner->SetLoadUnloadedAssets(bLoadUnscored);
+		Scanner->OnResults.BindSP(this, &SCognitiveComplexityDashboard::OnScanResults);
+		Scanner->Start(MoveTemp(BlueprintAssets));
+	}
 
-			const FString BlueprintName = Blueprint->GetName();
-			const FString BlueprintPath = PackagePathString;
+	void OnScanResults(const TArray<FCognitiveComplexityBlueprintResult>& Results)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SCognitiveComplexityDashboard::OnScanResults);
 
-			// Ask the calculator to process the Blueprint
-			const TArray<FCognitiveComplexityEntryResult> Results = Calculator.ProcessBlueprint(Blueprint);
+		// Every entry is kept regardless of the filters, so changing them never needs a rescan.
+		for (const FCognitiveComplexityBlueprintResult& BlueprintResult : Results)
+		{
+			const FText BlueprintText = FText::FromString(BlueprintResult.BlueprintName);
+			const FText PathText = FText::FromString(BlueprintResult.BlueprintPath);
+			const FText NoMetricText = NSLOCTEXT("BpCognitiveComplexity", "DashboardNoMetric", "-");
 
-			// Populate rows from results, filtering by threshold
-			for (const FCognitiveComplexityEntryResult& Result : Results)
+			for (const FCognitiveComplexityEntryResult& Result : BlueprintResult.Entries)
 			{
-				if (Result.Score.Percent >= ThresholdPercent)
+				FCognitiveComplexityEntryRowPtr Row = MakeShared<FCognitiveComplexityEntryRow>();
+				Row->BlueprintName = BlueprintResult.BlueprintName;
+				Row->BlueprintPath = BlueprintResult.BlueprintPath;
+				Row->NodeGuid = Result.NodeGuid;
+				Row->EntryDisplayName = Result.EntryDisplayName;
+				Row->RawScore = Result.Score.RawScore;
+				Row->Percent = Result.Score.Percent;
+				Row->SearchText = FString::Printf(TEXT("%s %s"), *BlueprintResult.BlueprintName, *Result.EntryDisplayName).ToLower();
+				Row->BlueprintSortKey = BlueprintResult.BlueprintName.ToLower();
+				Row->PathSortKey = BlueprintResult.BlueprintPath.ToLower();
+				Row->EntrySortKey = Result.EntryDisplayName.ToLower();
+				Row->RowIndex = AllRows.Num();
+				Row->BlueprintText = BlueprintText;
+				Row->PathText = PathText;
+				Row->EntryText = FText::FromString(Result.EntryDisplayName);
+				Row->PercentText = FText::AsNumber(FMath::RoundToInt(Result.Score.Percent));
+				Row->RawScoreText = FText::AsNumber(Result.Score.RawScore);
+				Row->Features = Result.Features;
+				Row->bHasFeatures = Result.bHasFeatures;
+				Row->Metrics = Result.Metrics;
+				Row->bHasMetrics = Result.bHasMetrics;
+				for (int32 MetricIndex = 0; MetricIndex < NumMetricColumns; ++MetricIndex)
 				{
-					FCognitiveComplexityEntryRowPtr Row = MakeShared<FCognitiveComplexityEntryRow>();
-					Row->BlueprintName = BlueprintName;
-					Row->BlueprintPath = BlueprintPath;
-					Row->NodeGuid = Result.NodeGuid;
-					Row->EntryDisplayName = Result.EntryDisplayName;
-					Row->RawScore = Result.Score.RawScore;
-					Row->Percent = Result.Score.Percent;
-
-					Rows.Add(Row);
+					Row->MetricTexts[MetricIndex] = Result.bHasMetrics ? FText::AsNumber(Result.Metrics.*MetricColumns[MetricIndex].Field) : NoMetricText;
 				}
+				NumRowsWithoutFeatures += Result.bHasFeatures ? 0 : 1;
+
+				if (bWhatIfActive)
+				{
+					EvaluateRow(*Row);
+				}
+
+				PendingRowIndices.Add(AllRows.Num());
+				AllRows.Add(MoveTemp(Row));
 			}
 		}
 
-		Rows.Sort([](const FCognitiveComplexityEntryRowPtr& A, const FCognitiveComplexityEntryRowPtr& B)
+		// Batches arriving within a frame are merged into the view together, once, on the next Slate tick.
+		if (!FlushTimerHandle.IsValid() && PendingRowIndices.Num() > 0)
+		{
+			FlushTimerHandle = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SCognitiveComplexityDashboard::FlushPendingRows));
+		}
+	}
+
+	/**
+	 * Sorts the rows that arrived since the last flush and merges them into the sorted order and,
+	 * after filtering only the new rows, into the visible rows. Both merges are linear.
+	 */
+	EActiveTimerReturnType FlushPendingRows(double InCurrentTime, float InDeltaTime)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SCognitiveComplexityDashboard::FlushPendingRows);
+
+		FlushTimerHandle.Reset();
+
+		TArray<int32> NewOrder = MoveTemp(PendingRowIndices);
+		if (NewOrder.Num() == 0)
+		{
+			return EActiveTimerReturnType::Stop;
+		}
+
+		NewOrder.Sort([this](int32 A, int32 B) { return IsRowLess(A, B); });
+
+		TArray<int32> MergedOrder;
+		MergedOrder.Reserve(SortedOrder.Num() + NewOrder.Num());
+		int32 OldCursor = 0;
+		int32 NewCursor = 0;
+		while (OldCursor < SortedOrder.Num() || NewCursor < NewOrder.Num())
 		{
-			if (!A.IsValid() || !B.IsValid())
+			const bool bTakeNew = OldCursor == SortedOrder.Num()
+				|| (NewCursor < NewOrder.Num() && IsRowLess(NewOrder[NewCursor], SortedOrder[OldCursor]));
+			MergedOrder.Add(bTakeNew ? NewOrder[NewCursor++] : SortedOrder[OldCursor++]);
+		}
+		SortedOrder = MoveTemp(MergedOrder);
+
+		// The visible rows are already filtered, so only the new ones need the filters.
+		TArray<FCognitiveComplexityEntryRowPtr> MergedRows;
+		MergedRows.Reserve(Rows.Num() + NewOrder.Num());
+		int32 RowCursor = 0;
+		for (const int32 NewIndex : NewOrder)
+		{
+			if (!PassesFilters(*AllRows[NewIndex]))
 			{
-				return A.IsValid();
+				continue;
 			}
 
-			// Sort by complexity (Percent) descending, then by Blueprint name and entry name for stability.
-			if (!FMath::IsNearlyEqual(A->Percent, B->Percent))
+			while (RowCursor < Rows.Num() && !IsRowLess(NewIndex, Rows[RowCursor]->RowIndex))
 			{
-				return A->Percent > B->Percent;
+				MergedRows.Add(MoveTemp(Rows[RowCursor++]));
 			}
+			MergedRows.Add(AllRows[NewIndex]);
+		}
 
-			if (A->BlueprintName != B->BlueprintName)
+		if (MergedRows.Num() > 0)
+		{
+			while (RowCursor < Rows.Num())
 			{
-				return A->BlueprintName < B->BlueprintName;
+				MergedRows.Add(MoveTemp(Rows[RowCursor++]));
 			}
+			Rows = MoveTemp(MergedRows);
 
-			return A->EntryDisplayName < B->EntryDisplayName;
-		});
-
-		if (ListViewWidget.IsValid())
-		{
-			ListViewWidget->RequestListRefresh();
+			if (ListViewWidget.IsValid())
+			{
+				ListViewWidget->RequestListRefresh();
+			}
 		}
+
+		return EActiveTimerReturnType::Stop;
 	}
 
 private:
 	float ThresholdPercent;
+
+	/** Every scanned entry, in arrival order. Rows are created once here and shared with the visible list. */
+	TArray<FCognitiveComplexityEntryRowPtr> AllRows;
+
+	/** Indices into AllRows under the current sort; maintained incrementally as results stream in. */
+	TArray<int32> SortedOrder;
+
+	/** Rows received since the last FlushPendingRows, not yet in SortedOrder or Rows. */
+	TArray<int32> PendingRowIndices;
+	TSharedPtr<FActiveTimerHandle> FlushTimerHandle;
+
+	/** The filtered view of SortedOrder that the list shows. */
 	TArray<FCognitiveComplexityEntryRowPtr> Rows;
+
+	FName SortColumn = ColumnPercent;
+	EColumnSortMode::Type SortMode = EColumnSortMode::Descending;
+	FString SearchText;
+	FString PathFilter;
+
 	TSharedPtr<SListView<FCognitiveComplexityEntryRowPtr>> ListViewWidget;
+	TSharedPtr<FCognitiveComplexityScanner> Scanner;
+	bool bScanCancelled = false;
+
+	/** Weights the rows are shown under. Equal to the settings until a what-if slider is moved. */
+	FCognitiveComplexityWeights WhatIfWeights;
+	bool bWhatIfActive = false;
+	int32 NumRowsWithoutFeatures = 0;
 };
 
 void FCognitiveComplexityDashboard::RegisterTabSpawner()
@@ -0,0 +1,248 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityFlatGraph.h"
+
+#include "Algo/Sort.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityStats.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+
+FCognitiveComplexityFlatGraph FCognitiveComplexityFlatGraph::Build(TConstArrayView<const UEdGraph*> Graphs, const FCognitiveComplexityCallGraph* CallGraph)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityFlatGraph::Build);
+
+	FCognitiveComplexityFlatGraph FlatGraph;
+
+	// First pass: number the nodes.
+	TArray<const UEdGraphNode*> Nodes;
+	TMap<const UEdGraphNode*, int32> NodeIndices;
+	TBitArray<> IsPure;
+
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (Graph == nullptr)
+		{
+			continue;
+		}
+
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node != nullptr)
+			{
+				NodeIndices.Add(Node, Nodes.Add(Node));
+				IsPure.Add(FCognitiveComplexityNodeClassifier::IsPure(Node));
+			}
+		}
+	}
+
+	FlatGraph.NodeGuids.Reserve(Nodes.Num());
+	FlatGraph.Categories.Reserve(Nodes.Num());
+	FlatGraph.CallSiteWeights.Reserve(Nodes.Num());
+	FlatGraph.SuccessorOffsets.Reserve(Nodes.Num() + 1);
+	FlatGraph.DataInputOffsets.Reserve(Nodes.Num() + 1);
+
+	// Second pass: categories and exec successors, in the pin/link order WalkNode uses.
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const UEdGraphNode* Node = Nodes[NodeIndex];
+		const ECognitiveComplexityNodeCategory Categories = FCognitiveComplexityNodeClassifier::Classify(Node);
+
+		FlatGraph.NodeGuids.Add(Node->NodeGuid);
+		FlatGraph.Categories.Add(Categories);
+		FlatGraph.CallSiteWeights.Add(CallGraph ? CallGraph->GetCallSiteScore(Node) : 0.0f);
+		FlatGraph.SuccessorOffsets.Add(FlatGraph.Successors.Num());
+		FlatGraph.DataInputOffsets.Add(FlatGraph.DataInputs.Num());
+
+		if (EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Entry))
+		{
+			FlatGraph.EntryIndices.Add(NodeIndex);
+		}
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin == nullptr)
+			{
+				continue;
+			}
+
+			const bool bIsExec = Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+			const bool bIsExecOutput = bIsExec && Pin->Direction == EGPD_Output;
+			const bool bIsDataInput = !bIsExec && Pin->Direction == EGPD_Input;
+			if (!bIsExecOutput && !bIsDataInput)
+			{
+				continue;
+			}
+
+			for (const UEdGraphPin* Linked : Pin->LinkedTo)
+			{
+				const int32* LinkedIndex = Linked ? NodeIndices.Find(Linked->GetOwningNode()) : nullptr;
+				if (LinkedIndex == nullptr)
+				{
+					continue;
+				}
+
+				if (bIsExecOutput)
+				{
+					FlatGraph.Successors.Add(*LinkedIndex);
+				}
+				else if (IsPure[*LinkedIndex])
+				{
+					FlatGraph.DataInputs.Add(*LinkedIndex);
+				}
+			}
+		}
+	}
+
+	FlatGraph.SuccessorOffsets.Add(FlatGraph.Successors.Num());
+	FlatGraph.DataInputOffsets.Add(FlatGraph.DataInputs.Num());
+
+	return FlatGraph;
+}
+
+void FCognitiveComplexityFlatGraph::ForEachDataInput(int32 NodeIndex, TFunctionRef<bool(int32 PureIndex)> Visit) const
+{
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Append(GetDataInputs(NodeIndex));
+
+	while (Stack.Num() > 0)
+	{
+		const int32 PureIndex = Stack.Pop(EAllowShrinking::No);
+		if (Visit(PureIndex))
+		{
+			Stack.Append(GetDataInputs(PureIndex));
+		}
+	}
+}
+
+FCognitiveComplexityCondensedGraph FCognitiveComplexityCondensedGraph::Build(const FCognitiveComplexityFlatGraph& Graph)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityCondensedGraph::Build);
+
+	FCognitiveComplexityCondensedGraph Condensed;
+
+	const int32 NumNodes = Graph.Num();
+	Condensed.ComponentOfNode.Init(INDEX_NONE, NumNodes);
+	Condensed.MemberOffsets.Reserve(NumNodes + 1);
+	Condensed.Members.Reserve(NumNodes);
+
+	// Iterative Tarjan, so long exec chains cannot overflow the stack.
+	TArray<int32> Index;
+	TArray<int32> LowLink;
+	Index.Init(INDEX_NONE, NumNodes);
+	LowLink.Init(INDEX_NONE, NumNodes);
+	TBitArray<> OnStack(false, NumNodes);
+	TArray<int32> ComponentStack;
+	TArray<TPair<int32, int32>> CallStack;
+	int32 NextIndex = 0;
+
+	for (int32 Root = 0; Root < NumNodes; ++Root)
+	{
+		if (Index[Root] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		Index[Root] = LowLink[Root] = NextIndex++;
+		ComponentStack.Push(Root);
+		OnStack[Root] = true;
+		CallStack.Emplace(Root, 0);
+
+		while (CallStack.Num() > 0)
+		{
+			const int32 Node = CallStack.Last().Key;
+			const TConstArrayView<int32> NodeSuccessors = Graph.GetSuccessors(Node);
+
+			if (CallStack.Last().Value < NodeSuccessors.Num())
+			{
+				const int32 Successor = NodeSuccessors[CallStack.Last().Value++];
+				if (Index[Successor] == INDEX_NONE)
+				{
+					Index[Successor] = LowLink[Successor] = NextIndex++;
+					ComponentStack.Push(Successor);
+					OnStack[Successor] = true;
+					CallStack.Emplace(Successor, 0);
+				}
+				else if (OnStack[Successor])
+				{
+					LowLink[Node] = FMath::Min(LowLink[Node], Index[Successor]);
+				}
+				continue;
+			}
+
+			CallStack.Pop(EAllowShrinking::No);
+			if (CallStack.Num() > 0)
+			{
+				const int32 Parent = CallStack.Last().Key;
+				LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[Node]);
+			}
+
+			if (LowLink[Node] == Index[Node])
+			{
+				const int32 Component = Condensed.MemberOffsets.Num();
+				const int32 FirstMember = Condensed.Members.Num();
+				Condensed.MemberOffsets.Add(FirstMember);
+
+				int32 Member = INDEX_NONE;
+				do
+				{
+					Member = ComponentStack.Pop(EAllowShrinking::No);
+					OnStack[Member] = false;
+					Condensed.ComponentOfNode[Member] = Component;
+					Condensed.Members.Add(Member);
+				}
+				while (Member != Node);
+
+				Algo::Sort(MakeArrayView(Condensed.Members.GetData() + FirstMember, Condensed.Members.Num() - FirstMember));
+			}
+		}
+	}
+
+	Condensed.MemberOffsets.Add(Condensed.Members.Num());
+
+	// Successor components. A component reached over both a nesting and a plain link keeps the
+	// plain one, i.e. the shallower depth, which is what makes the result independent of pin order.
+	const int32 NumComponents = Condensed.Num();
+	Condensed.SuccessorOffsets.Reserve(NumComponents + 1);
+
+	TMap<int32, uint8> Reached;
+	for (int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		Condensed.SuccessorOffsets.Add(Condensed.Successors.Num());
+		Reached.Reset();
+
+		for (const int32 Member : Condensed.GetMembers(Component))
+		{
+			const uint8 bNested = FCognitiveComplexityNodeClassifier::IncreasesNesting(Graph.Categories[Member]) ? 1 : 0;
+			for (const int32 Successor : Graph.GetSuccessors(Member))
+			{
+				const int32 SuccessorComponent = Condensed.ComponentOfNode[Successor];
+				if (SuccessorComponent == Component)
+				{
+					continue;
+				}
+
+				uint8& Nested = Reached.FindOrAdd(SuccessorComponent, bNested);
+				Nested &= bNested;
+			}
+		}
+
+		// Members are sorted, so a component's first member is its lowest node index.
+		Reached.KeySort([&Condensed](int32 A, int32 B)
+		{
+			return Condensed.Members[Condensed.MemberOffsets[A]] < Condensed.Members[Condensed.MemberOffsets[B]];
+		});
+
+		for (const TPair<int32, uint8>& Pair : Reached)
+		{
+			Condensed.Successors.Add(Pair.Key);
+			Condensed.SuccessorNested.Add(Pair.Value);
+		}
+	}
+
+	Condensed.SuccessorOffsets.Add(Condensed.Successors.Num());
+
+	return Condensed;
+}
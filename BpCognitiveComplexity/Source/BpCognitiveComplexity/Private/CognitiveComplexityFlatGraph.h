@@ -0,0 +1,100 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityNodeClassifier.h"
+
+class UEdGraph;
+class FCognitiveComplexityCallGraph;
+
+/**
+ * Compact copy of the exec topology of one or more graphs.
+ *
+ * Nodes are renumbered 0..N-1 in graph order and their exec successors are stored as a CSR
+ * array (offsets + flat successor list) in the same order WalkNode visits pins and links.
+ * Together with the per-node category bits this is everything the calculator needs, so it
+ * can be walked iteratively without touching UObjects or chasing pin pointers.
+ *
+ * The pure nodes feeding each node's data inputs are stored the same way, for the data-flow pass.
+ */
+struct FCognitiveComplexityFlatGraph
+{
+	/** Flattens the given graphs, taking call site weights from CallGraph if given. Must run on the game thread. */
+	static FCognitiveComplexityFlatGraph Build(TConstArrayView<const UEdGraph*> Graphs, const FCognitiveComplexityCallGraph* CallGraph = nullptr);
+
+	int32 Num() const { return NodeGuids.Num(); }
+
+	TConstArrayView<int32> GetSuccessors(int32 NodeIndex) const
+	{
+		return MakeArrayView(Successors.GetData() + SuccessorOffsets[NodeIndex], SuccessorOffsets[NodeIndex + 1] - SuccessorOffsets[NodeIndex]);
+	}
+
+	TConstArrayView<int32> GetDataInputs(int32 NodeIndex) const
+	{
+		return MakeArrayView(DataInputs.GetData() + DataInputOffsets[NodeIndex], DataInputOffsets[NodeIndex + 1] - DataInputOffsets[NodeIndex]);
+	}
+
+	TArray<FGuid> NodeGuids;
+	TArray<ECognitiveComplexityNodeCategory> Categories;
+
+	/** Callee score each node adds on top of its category weights; zero unless built with a call graph. */
+	TArray<float> CallSiteWeights;
+
+	/** Successors of node I are Successors[SuccessorOffsets[I] .. SuccessorOffsets[I + 1]). Holds Num() + 1 offsets. */
+	TArray<int32> SuccessorOffsets;
+	TArray<int32> Successors;
+
+	/** Pure nodes linked to the data inputs of node I are DataInputs[DataInputOffsets[I] .. DataInputOffsets[I + 1]). */
+	TArray<int32> DataInputOffsets;
+	TArray<int32> DataInputs;
+
+	/**
+	 * Visits the pure expression DAG feeding a node, depth-first through data inputs. Visit returns
+	 * false for nodes it has already seen, which are then not expanded again.
+	 */
+	void ForEachDataInput(int32 NodeIndex, TFunctionRef<bool(int32 PureIndex)> Visit) const;
+
+	/** Indices of entry nodes (events and function entries) in graph order. */
+	TArray<int32> EntryIndices;
+};
+
+/**
+ * Strongly connected components of a flat graph's exec topology.
+ *
+ * Exec cycles (reroutes looping back, manual loops) collapse into a single component, so the
+ * components form a DAG the memoized scoring mode can walk without looping. Components are
+ * numbered in completion order, which puts every successor before its predecessors.
+ */
+struct FCognitiveComplexityCondensedGraph
+{
+	static FCognitiveComplexityCondensedGraph Build(const FCognitiveComplexityFlatGraph& Graph);
+
+	int32 Num() const { return MemberOffsets.Num() - 1; }
+
+	TConstArrayView<int32> GetMembers(int32 Component) const
+	{
+		return MakeArrayView(Members.GetData() + MemberOffsets[Component], MemberOffsets[Component + 1] - MemberOffsets[Component]);
+	}
+
+	TConstArrayView<int32> GetSuccessors(int32 Component) const
+	{
+		return MakeArrayView(Successors.GetData() + SuccessorOffsets[Component], SuccessorOffsets[Component + 1] - SuccessorOffsets[Component]);
+	}
+
+	/** Component of each flat graph node. */
+	TArray<int32> ComponentOfNode;
+
+	/** Flat graph nodes of each component in ascending order, as CSR. Holds Num() + 1 offsets. */
+	TArray<int32> MemberOffsets;
+	TArray<int32> Members;
+
+	/**
+	 * Distinct successor components of each component, as CSR, ordered by their lowest member
+	 * node so the order never depends on pin order. SuccessorNested is parallel to Successors
+	 * and is 1 when every exec link into that successor leaves a nesting node.
+	 */
+	TArray<int32> SuccessorOffsets;
+	TArray<int32> Successors;
+	TArray<uint8> SuccessorNested;
+};
@@ -0,0 +1,46 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityMetricVisitor.h"
+
+FCognitiveComplexityMetricVisitor::FCognitiveComplexityMetricVisitor()
+{
+	Accumulators.Add(&CyclomaticAccumulator);
+	Accumulators.Add(&NodeCountAccumulator);
+	Accumulators.Add(&MaxNestingAccumulator);
+	Accumulators.Add(&MaxFanOutAccumulator);
+	Accumulators.Add(&LatentCountAccumulator);
+}
+
+FCognitiveComplexityMetrics FCognitiveComplexityMetricVisitor::Finish() const
+{
+	FCognitiveComplexityMetrics Metrics;
+	for (const ICognitiveComplexityMetricAccumulator* Accumulator : Accumulators)
+	{
+		Accumulator->Finish(Metrics);
+	}
+	return Metrics;
+}
+
+void FCognitiveComplexityMetricVisitor::FCyclomaticAccumulator::Visit(const FCognitiveComplexityVisit& Node)
+{
+	// Every exec link of a reached node leads to a reached node, so the reached exec nodes and
+	// their links form the whole control-flow graph of the entry.
+	if (!Node.bPure)
+	{
+		++NumExecNodes;
+		NumExecLinks += Node.NumExecLinks;
+	}
+}
+
+void FCognitiveComplexityMetricVisitor::FCyclomaticAccumulator::Finish(FCognitiveComplexityMetrics& OutMetrics) const
+{
+	OutMetrics.Cyclomatic = NumExecNodes > 0 ? NumExecLinks - NumExecNodes + 2 : 0;
+}
+
+void FCognitiveComplexityMetricVisitor::FLatentCountAccumulator::Visit(const FCognitiveComplexityVisit& Node)
+{
+	if (EnumHasAnyFlags(Node.Categories, ECognitiveComplexityNodeCategory::Latent))
+	{
+		++LatentCount;
+	}
+}
@@ -0,0 +1,125 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityNodeClassifier.h"
+#include "CognitiveComplexityTypes.h"
+
+/** One node reached by a scoring walk, as seen by the metric accumulators. */
+struct FCognitiveComplexityVisit
+{
+	ECognitiveComplexityNodeCategory Categories = ECognitiveComplexityNodeCategory::None;
+
+	/** Nesting depth the node was reached at. Pure nodes report the depth of the exec node they feed. */
+	int32 Depth = 0;
+
+	/** Exec links leaving the node, including links to nodes the walk had already reached. Always 0 for pure nodes. */
+	int32 NumExecLinks = 0;
+
+	/** Reached through a data input by the data-flow pass rather than over an exec link. */
+	bool bPure = false;
+};
+
+/**
+ * Computes one metric from the nodes a scoring walk reaches. Every reached node is visited exactly
+ * once per entry, in no particular order, so accumulators must not depend on the visit order.
+ */
+class ICognitiveComplexityMetricAccumulator
+{
+public:
+	virtual ~ICognitiveComplexityMetricAccumulator() = default;
+
+	virtual void Visit(const FCognitiveComplexityVisit& Node) = 0;
+
+	/** Writes the metric into its field once the walk is done. */
+	virtual void Finish(FCognitiveComplexityMetrics& OutMetrics) const = 0;
+};
+
+/**
+ * Fans the nodes of one entry walk out to any number of metric accumulators, so every metric is
+ * collected by the traversal that computes the score instead of by a pass of its own.
+ *
+ * The built-in accumulators for FCognitiveComplexityMetrics are always registered; AddAccumulator
+ * adds more. A visitor belongs to a single walk and is not thread-safe.
+ */
+class FCognitiveComplexityMetricVisitor
+{
+public:
+	FCognitiveComplexityMetricVisitor();
+	FCognitiveComplexityMetricVisitor(const FCognitiveComplexityMetricVisitor&) = delete;
+	FCognitiveComplexityMetricVisitor& operator=(const FCognitiveComplexityMetricVisitor&) = delete;
+
+	/** Feeds Accumulator as well. It must outlive the visitor. */
+	void AddAccumulator(ICognitiveComplexityMetricAccumulator& Accumulator) { Accumulators.Add(&Accumulator); }
+
+	void Visit(const FCognitiveComplexityVisit& Node)
+	{
+		for (ICognitiveComplexityMetricAccumulator* Accumulator : Accumulators)
+		{
+			Accumulator->Visit(Node);
+		}
+	}
+
+	FCognitiveComplexityMetrics Finish() const;
+
+private:
+	class FCyclomaticAccumulator : public ICognitiveComplexityMetricAccumulator
+	{
+	public:
+		virtual void Visit(const FCognitiveComplexityVisit& Node) override;
+		virtual void Finish(FCognitiveComplexityMetrics& OutMetrics) const override;
+
+	private:
+		int32 NumExecNodes = 0;
+		int32 NumExecLinks = 0;
+	};
+
+	class FNodeCountAccumulator : public ICognitiveComplexityMetricAccumulator
+	{
+	public:
+		virtual void Visit(const FCognitiveComplexityVisit& Node) override { ++NodeCount; }
+		virtual void Finish(FCognitiveComplexityMetrics& OutMetrics) const override { OutMetrics.NodeCount = NodeCount; }
+
+	private:
+		int32 NodeCount = 0;
+	};
+
+	class FMaxNestingAccumulator : public ICognitiveComplexityMetricAccumulator
+	{
+	public:
+		virtual void Visit(const FCognitiveComplexityVisit& Node) override { MaxNesting = FMath::Max(MaxNesting, Node.Depth); }
+		virtual void Finish(FCognitiveComplexityMetrics& OutMetrics) const override { OutMetrics.MaxNesting = MaxNesting; }
+
+	private:
+		int32 MaxNesting = 0;
+	};
+
+	class FMaxFanOutAccumulator : public ICognitiveComplexityMetricAccumulator
+	{
+	public:
+		virtual void Visit(const FCognitiveComplexityVisit& Node) override { MaxFanOut = FMath::Max(MaxFanOut, Node.NumExecLinks); }
+		virtual void Finish(FCognitiveComplexityMetrics& OutMetrics) const override { OutMetrics.MaxFanOut = MaxFanOut; }
+
+	private:
+		int32 MaxFanOut = 0;
+	};
+
+	class FLatentCountAccumulator : public ICognitiveComplexityMetricAccumulator
+	{
+	public:
+		virtual void Visit(const FCognitiveComplexityVisit& Node) override;
+		virtual void Finish(FCognitiveComplexityMetrics& OutMetrics) const override { OutMetrics.LatentCount = LatentCount; }
+
+	private:
+		int32 LatentCount = 0;
+	};
+
+	FCyclomaticAccumulator CyclomaticAccumulator;
+	FNodeCountAccumulator NodeCountAccumulator;
+	FMaxNestingAccumulator MaxNestingAccumulator;
+	FMaxFanOutAccumulator MaxFanOutAccumulator;
+	FLatentCountAccumulator LatentCountAccumulator;
+
+	TArray<ICognitiveComplexityMetricAccumulator*, TInlineAllocator<8>> Accumulators;
+};
@@ -0,0 +1,293 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityNodeClassifier.h"
+
+#include "BpCognitiveComplexitySettings.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_MathExpression.h"
+#include "Engine/Blueprint.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+
+namespace CognitiveComplexityNodeClassifier
+{
+	/** What a node's class alone tells us, plus which per-instance checks are still needed. */
+	struct FClassInfo
+	{
+		ECognitiveComplexityNodeCategory Categories = ECognitiveComplexityNodeCategory::None;
+		bool bIsMacroInstance = false;
+		bool bCheckPureMath = false;
+		bool bCheckMathCall = false;
+	};
+
+	static FRWLock ClassTableLock;
+	static TMap<const UClass*, FClassInfo> ClassTable;
+
+	static FRWLock MacroTableLock;
+	static TMap<FObjectKey, ECognitiveComplexityNodeCategory> MacroTable;
+
+	static bool NameIsOneOf(FName ClassName, std::initializer_list<FName> Names)
+	{
+		for (FName Name : Names)
+		{
+			if (ClassName == Name)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool HasExecOutputs(const UEdGraphNode* Node)
+	{
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin && Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Whether a call node is a pure math-library operator or a conversion (Add_IntInt, the
+	 * commutative binary operators, Conv_*). Those read as math, not as calls to follow.
+	 */
+	static bool IsPureMathCall(const UK2Node_CallFunction* CallNode)
+	{
+		if (!CallNode->IsNodePure())
+		{
+			return false;
+		}
+
+		const UClass* LibraryClass = CallNode->FunctionReference.GetMemberParentClass();
+		if (LibraryClass != nullptr && LibraryClass->IsChildOf<UKismetMathLibrary>())
+		{
+			return true;
+		}
+
+		// Copied into a stack buffer, so classifying a call never allocates.
+		const FNameBuilder MemberName(CallNode->FunctionReference.GetMemberName());
+		return MemberName.ToView().StartsWith(TEXT("Conv_"), ESearchCase::CaseSensitive);
+	}
+
+	static FClassInfo ComputeClassInfo(const UClass* NodeClass)
+	{
+		FClassInfo Info;
+
+		const FName ClassName = NodeClass->GetFName();
+		const FString ClassNameStr = ClassName.ToString();
+
+		if (NameIsOneOf(ClassName, { TEXT("K2Node_Event"), TEXT("K2Node_FunctionEntry") }))
+		{
+			Info.Categories |= ECognitiveComplexityNodeCategory::Entry;
+		}
+
+		// Native loop-style nodes, and ForEach nodes shipped as separate classes.
+		if (ClassNameStr.Contains(TEXT("ForLoop")) || ClassNameStr.Contains(TEXT("WhileLoop"))
+			|| NameIsOneOf(ClassName, { TEXT("K2Node_MapForEach"), TEXT("K2Node_SetForEach"), TEXT("K2Node_ForEachElementInEnum") }))
+		{
+			Info.Categories |= ECognitiveComplexityNodeCategory::Loop;
+		}
+
+		if (NameIsOneOf(ClassName, { TEXT("K2Node_IfThenElse"), TEXT("K2Node_ExecutionSequence"), TEXT("K2Node_MultiGate") }))
+		{
+			Info.Categories |= ECognitiveComplexityNodeCategory::Branch;
+		}
+
+		if (NameIsOneOf(ClassName, { TEXT("K2Node_Select"), TEXT("K2Node_SwitchInteger"), TEXT("K2Node_SwitchEnum"), TEXT("K2Node_SwitchName"), TEXT("K2Node_SwitchString"), TEXT("K2Node_Switch") }))
+		{
+			Info.Categories |= ECognitiveComplexityNodeCategory::Select;
+		}
+
+		// Latent/async nodes - matched by name because several of these classes ship without public headers.
+		if (NameIsOneOf(ClassName, { TEXT("K2Node_Timeline"), TEXT("K2Node_BaseAsyncTask"), TEXT("K2Node_AsyncAction") })
+			|| ClassNameStr.Contains(TEXT("LatentGameplayCall")) || ClassNameStr.Contains(TEXT("AsyncTask")))
+		{
+			Info.Categories |= ECognitiveComplexityNodeCategory::Latent;
+		}
+
+		// Function calls and math are exclusive. Call nodes count as calls unless they are pure
+		// math-library operators or conversions (including CommutativeAssociativeBinaryOperator),
+		// which depends on the instance.
+		if (NodeClass->IsChildOf<UK2Node_CallFunction>())
+		{
+			Info.bCheckMathCall = true;
+		}
+		else if (NodeClass->IsChildOf<UK2Node_MathExpression>())
+		{
+			Info.Categories |= ECognitiveComplexityNodeCategory::Math;
+		}
+		else if (NodeClass->IsChildOf<UK2Node>())
+		{
+			// Generic pure nodes with no exec pins count as math; that depends on the instance.
+			Info.bCheckPureMath = true;
+		}
+
+		// Macro-based loops (e.g. standard library ForLoop/WhileLoop macros) depend on the referenced macro graph.
+		Info.bIsMacroInstance = NodeClass->IsChildOf<UK2Node_MacroInstance>();
+
+		return Info;
+	}
+
+	static bool LibraryListContains(const TArray<TSoftObjectPtr<UBlueprint>>& Libraries, const FSoftObjectPath& LibraryPath)
+	{
+		for (const TSoftObjectPtr<UBlueprint>& Library : Libraries)
+		{
+			if (Library.ToSoftObjectPath() == LibraryPath)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static ECognitiveComplexityNodeCategory ComputeMacroCategories(const UEdGraph* MacroGraph)
+	{
+		ECognitiveComplexityNodeCategory Categories = ECognitiveComplexityNodeCategory::None;
+
+		// Standard library loop macros (ForLoop, ForEachLoop, WhileLoop, ...) are recognised by name.
+		const FString MacroName = MacroGraph->GetName();
+		if (MacroName.Contains(TEXT("ForLoop")) || MacroName.Contains(TEXT("ForEach")) || MacroName.Contains(TEXT("While")))
+		{
+			Categories |= ECognitiveComplexityNodeCategory::Loop;
+		}
+
+		const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+		const UBlueprint* MacroLibrary = MacroGraph->GetTypedOuter<UBlueprint>();
+		if (Settings == nullptr || MacroLibrary == nullptr)
+		{
+			return Categories;
+		}
+
+		const FSoftObjectPath LibraryPath(MacroLibrary);
+		if (LibraryListContains(Settings->LoopMacroLibraries, LibraryPath))
+		{
+			Categories |= ECognitiveComplexityNodeCategory::Loop;
+		}
+		if (LibraryListContains(Settings->BranchMacroLibraries, LibraryPath))
+		{
+			Categories |= ECognitiveComplexityNodeCategory::Branch;
+		}
+		if (LibraryListContains(Settings->LatentMacroLibraries, LibraryPath))
+		{
+			Categories |= ECognitiveComplexityNodeCategory::Latent;
+		}
+
+		return Categories;
+	}
+
+	static ECognitiveComplexityNodeCategory ClassifyMacro(const UEdGraph* MacroGraph, bool bUseTable)
+	{
+		if (MacroGraph == nullptr)
+		{
+			return ECognitiveComplexityNodeCategory::None;
+		}
+
+		if (!bUseTable)
+		{
+			return ComputeMacroCategories(MacroGraph);
+		}
+
+		const FObjectKey MacroKey(MacroGraph);
+		{
+			FReadScopeLock ReadLock(MacroTableLock);
+			if (const ECognitiveComplexityNodeCategory* Categories = MacroTable.Find(MacroKey))
+			{
+				return *Categories;
+			}
+		}
+
+		const ECognitiveComplexityNodeCategory Categories = ComputeMacroCategories(MacroGraph);
+		{
+			FWriteScopeLock WriteLock(MacroTableLock);
+			MacroTable.Add(MacroKey, Categories);
+		}
+		return Categories;
+	}
+
+	static ECognitiveComplexityNodeCategory ClassifyInstance(const UEdGraphNode* Node, const FClassInfo& Info, bool bUseTable)
+	{
+		ECognitiveComplexityNodeCategory Categories = Info.Categories;
+
+		if (Info.bIsMacroInstance)
+		{
+			Categories |= ClassifyMacro(CastChecked<UK2Node_MacroInstance>(Node)->GetMacroGraph(), bUseTable);
+		}
+
+		if (Info.bCheckPureMath && !HasExecOutputs(Node) && CastChecked<UK2Node>(Node)->IsNodePure())
+		{
+			Categories |= ECognitiveComplexityNodeCategory::Math;
+		}
+
+		if (Info.bCheckMathCall)
+		{
+			Categories |= IsPureMathCall(CastChecked<UK2Node_CallFunction>(Node)) ? ECognitiveComplexityNodeCategory::Math : ECognitiveComplexityNodeCategory::FunctionCall;
+		}
+
+		return Categories;
+	}
+}
+
+ECognitiveComplexityNodeCategory FCognitiveComplexityNodeClassifier::Classify(const UEdGraphNode* Node)
+{
+	using namespace CognitiveComplexityNodeClassifier;
+
+	if (Node == nullptr)
+	{
+		return ECognitiveComplexityNodeCategory::None;
+	}
+
+	const UClass* NodeClass = Node->GetClass();
+
+	{
+		FReadScopeLock ReadLock(ClassTableLock);
+		if (const FClassInfo* Info = ClassTable.Find(NodeClass))
+		{
+			return ClassifyInstance(Node, *Info, /*bUseTable*/true);
+		}
+	}
+
+	// Node classes are few and native, so the table stays tiny and is filled within the first few nodes.
+	const FClassInfo Info = ComputeClassInfo(NodeClass);
+	{
+		FWriteScopeLock WriteLock(ClassTableLock);
+		ClassTable.Add(NodeClass, Info);
+	}
+
+	return ClassifyInstance(Node, Info, /*bUseTable*/true);
+}
+
+ECognitiveComplexityNodeCategory FCognitiveComplexityNodeClassifier::ClassifyUncached(const UEdGraphNode* Node)
+{
+	using namespace CognitiveComplexityNodeClassifier;
+
+	if (Node == nullptr)
+	{
+		return ECognitiveComplexityNodeCategory::None;
+	}
+
+	return ClassifyInstance(Node, ComputeClassInfo(Node->GetClass()), /*bUseTable*/false);
+}
+
+bool FCognitiveComplexityNodeClassifier::IsPure(const UEdGraphNode* Node)
+{
+	const UK2Node* K2Node = Cast<UK2Node>(Node);
+	return K2Node != nullptr && K2Node->IsNodePure();
+}
+
+void FCognitiveComplexityNodeClassifier::ResetMacroTable()
+{
+	using namespace CognitiveComplexityNodeClassifier;
+
+	FWriteScopeLock WriteLock(MacroTableLock);
+	MacroTable.Reset();
+}
@@ -0,0 +1,56 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraphNode;
+
+/** Weighted node categories. Bit positions index FCognitiveComplexityCalculator's weight table. */
+enum class ECognitiveComplexityNodeCategory : uint8
+{
+	None = 0,
+	Entry = 1 << 0,
+	Branch = 1 << 1,
+	Select = 1 << 2,
+	Loop = 1 << 3,
+	Latent = 1 << 4,
+	FunctionCall = 1 << 5,
+	Math = 1 << 6,
+};
+
+ENUM_CLASS_FLAGS(ECognitiveComplexityNodeCategory);
+
+/**
+ * Maps graph nodes to category bits.
+ *
+ * Everything that depends only on the node's class (name matching, IsA checks) is computed
+ * once per UClass and kept in a flat lookup table, so classifying a node is one map lookup
+ * plus the few checks that genuinely depend on the instance (pure math nodes, math-library
+ * calls, macro instances).
+ * Macro instances are classified by the macro graph they reference, memoized per macro graph.
+ * Safe to call from any thread.
+ */
+class FCognitiveComplexityNodeClassifier
+{
+public:
+	static constexpr int32 NumCategories = 7;
+
+	/** Category bits for a node, using the per-class table. */
+	static ECognitiveComplexityNodeCategory Classify(const UEdGraphNode* Node);
+
+	/** Same result as Classify but recomputed from scratch without the table. Used by benchmarks. */
+	static ECognitiveComplexityNodeCategory ClassifyUncached(const UEdGraphNode* Node);
+
+	/** Forgets memoized macro classifications, e.g. after the macro library settings changed. */
+	static void ResetMacroTable();
+
+	/** Whether a node is a pure K2 node, i.e. evaluated on demand through its outputs rather than executed. */
+	static bool IsPure(const UEdGraphNode* Node);
+
+	/** Whether nodes of these categories nest their exec outputs one level deeper. */
+	static bool IncreasesNesting(ECognitiveComplexityNodeCategory Categories)
+	{
+		return EnumHasAnyFlags(Categories, ECognitiveComplexityNodeCategory::Loop | ECognitiveComplexityNodeCategory::Branch | ECognitiveComplexityNodeCategory::Select);
+	}
+};
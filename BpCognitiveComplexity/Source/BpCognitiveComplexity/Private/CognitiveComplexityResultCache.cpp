@@ -0,0 +1,277 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityResultCache.h"
+
+#include "Algo/AllOf.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BpCognitiveComplexity.h"
+#include "CognitiveComplexityStats.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+
+DEFINE_STAT(STAT_BpCognitiveComplexity_ResultCacheHits);
+
+namespace CognitiveComplexityResultCache
+{
+	static constexpr uint32 FileMagic = 0x43434242; // "BBCC"
+
+	/** Bump whenever the record layout or the meaning of a score changes so old files are discarded. */
+	static constexpr int32 FileVersion = 4;
+
+	static void SerializeResult(FArchive& Ar, FCognitiveComplexityBlueprintResult& Result)
+	{
+		Ar << Result.BlueprintName;
+		Ar << Result.BlueprintPath;
+		Ar << Result.PackageName;
+
+		int32 NumEntries = Result.Entries.Num();
+		Ar << NumEntries;
+		if (Ar.IsLoading())
+		{
+			if (NumEntries < 0 || NumEntries > Ar.TotalSize())
+			{
+				Ar.SetError();
+				return;
+			}
+			Result.Entries.SetNum(NumEntries);
+		}
+
+		for (FCognitiveComplexityEntryResult& Entry : Result.Entries)
+		{
+			Ar << Entry.NodeGuid;
+			Ar << Entry.EntryDisplayName;
+			Ar << Entry.Score.RawScore;
+			Ar << Entry.Score.Percent;
+			Ar << Entry.bHasFeatures;
+
+			if (Entry.bHasFeatures)
+			{
+				FCognitiveComplexityFeatures& Features = Entry.Features;
+				for (float& Count : Features.CategoryCounts)
+				{
+					Ar << Count;
+				}
+				Ar << Features.DepthSum;
+				Ar << Features.DataFlowMathCount;
+				Ar << Features.DataFlowCallCount;
+				Ar << Features.CalleeScore;
+			}
+
+			Ar << Entry.bHasMetrics;
+
+			if (Entry.bHasMetrics)
+			{
+				FCognitiveComplexityMetrics& Metrics = Entry.Metrics;
+				Ar << Metrics.Cyclomatic;
+				Ar << Metrics.NodeCount;
+				Ar << Metrics.MaxNesting;
+				Ar << Metrics.MaxFanOut;
+				Ar << Metrics.LatentCount;
+			}
+		}
+	}
+}
+
+FCognitiveComplexityResultCache::FCognitiveComplexityResultCache(FString InFilePath)
+	: FilePath(MoveTemp(InFilePath))
+{
+}
+
+FString FCognitiveComplexityResultCache::GetDefaultFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BpCognitiveComplexity"), TEXT("ResultCache.bin"));
+}
+
+bool FCognitiveComplexityResultCache::Load()
+{
+	using namespace CognitiveComplexityResultCache;
+
+	Records.Reset();
+	bDirty = false;
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(Bytes);
+	FNameAsStringProxyArchive Ar(MemoryReader);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumRecords = 0;
+	Ar << Magic << Version << NumRecords;
+
+	if (Ar.IsError() || Magic != FileMagic || Version != FileVersion || NumRecords < 0)
+	{
+		return false;
+	}
+
+	Records.Reserve(NumRecords);
+	for (int32 Index = 0; Index < NumRecords && !Ar.IsError(); ++Index)
+	{
+		FRecord Record;
+		Ar << Record.PackageSavedHash;
+		Ar << Record.SettingsHash;
+		Ar << Record.FeatureHash;
+		SerializeResult(Ar, Record.Result);
+		Ar << Record.CalleePackageHashes;
+
+		const FName PackageName = Record.Result.PackageName;
+		Records.Add(PackageName, MoveTemp(Record));
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogBpCognitiveComplexity, Warning, TEXT("Discarding corrupt result cache '%s'."), *FilePath);
+		Records.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FCognitiveComplexityResultCache::Save()
+{
+	using namespace CognitiveComplexityResultCache;
+
+	if (!bDirty)
+	{
+		return true;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter MemoryWriter(Bytes);
+	FNameAsStringProxyArchive Ar(MemoryWriter);
+
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	int32 NumRecords = Records.Num();
+	Ar << Magic << Version << NumRecords;
+
+	for (TPair<FName, FRecord>& Pair : Records)
+	{
+		Ar << Pair.Value.PackageSavedHash;
+		Ar << Pair.Value.SettingsHash;
+		Ar << Pair.Value.FeatureHash;
+		SerializeResult(Ar, Pair.Value.Result);
+		Ar << Pair.Value.CalleePackageHashes;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogBpCognitiveComplexity, Warning, TEXT("Failed to write result cache '%s'."), *FilePath);
+		return false;
+	}
+
+	bDirty = false;
+	return true;
+}
+
+bool FCognitiveComplexityResultCache::Find(const FAssetData& AssetData, uint32 SettingsHash, uint32 FeatureHash, const FCognitiveComplexityWeights& Weights, FCognitiveComplexityBlueprintResult& OutResult) const
+{
+	const FRecord* Record = Records.Find(AssetData.PackageName);
+	if (Record == nullptr)
+	{
+		return false;
+	}
+
+	// Scores are linear in the weights, so a record whose nodes were counted the same way is
+	// still usable after a weight change as long as every entry kept its features.
+	const bool bReweight = Record->SettingsHash != SettingsHash;
+	if (bReweight && (Record->FeatureHash != FeatureHash || !Algo::AllOf(Record->Result.Entries, &FCognitiveComplexityEntryResult::bHasFeatures)))
+	{
+		return false;
+	}
+
+	FIoHash SavedHash;
+	if (!GetPackageSavedHash(AssetData.PackageName, SavedHash) || SavedHash != Record->PackageSavedHash)
+	{
+		return false;
+	}
+
+	// Callee scores are baked into the entries, so an edited callee makes the record stale too.
+	for (const TPair<FName, FIoHash>& Callee : Record->CalleePackageHashes)
+	{
+		if (!GetPackageSavedHash(Callee.Key, SavedHash) || SavedHash != Callee.Value)
+		{
+			return false;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_BpCognitiveComplexity_ResultCacheHits);
+
+	OutResult = Record->Result;
+
+	if (bReweight)
+	{
+		for (FCognitiveComplexityEntryResult& Entry : OutResult.Entries)
+		{
+			Entry.Score = Entry.Features.Evaluate(Weights);
+		}
+	}
+
+	return true;
+}
+
+void FCognitiveComplexityResultCache::Store(const FCognitiveComplexityBlueprintResult& Result, uint32 SettingsHash, uint32 FeatureHash, TConstArrayView<FName> CalleePackages)
+{
+	FIoHash SavedHash;
+	if (!GetPackageSavedHash(Result.PackageName, SavedHash))
+	{
+		// Unsaved edits: whatever was cached for the saved package may still be valid, but this result is not.
+		return;
+	}
+
+	TArray<TPair<FName, FIoHash>> CalleePackageHashes;
+	CalleePackageHashes.Reserve(CalleePackages.Num());
+	for (const FName CalleePackage : CalleePackages)
+	{
+		FIoHash CalleeHash;
+		if (!GetPackageSavedHash(CalleePackage, CalleeHash))
+		{
+			return;
+		}
+		CalleePackageHashes.Emplace(CalleePackage, CalleeHash);
+	}
+
+	FRecord& Record = Records.FindOrAdd(Result.PackageName);
+	Record.PackageSavedHash = SavedHash;
+	Record.SettingsHash = SettingsHash;
+	Record.FeatureHash = FeatureHash;
+	Record.Result = Result;
+	Record.CalleePackageHashes = MoveTemp(CalleePackageHashes);
+	bDirty = true;
+}
+
+bool FCognitiveComplexityResultCache::GetPackageSavedHash(FName PackageName, FIoHash& OutHash)
+{
+	if (const UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+	{
+		if (Package->IsDirty())
+		{
+			return false;
+		}
+	}
+
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (AssetRegistry == nullptr)
+	{
+		return false;
+	}
+
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName);
+	if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+	{
+		return false;
+	}
+
+	OutHash = PackageData->GetPackageSavedHash();
+	return true;
+}
@@ -0,0 +1,69 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityTypes.h"
+#include "IO/IoHash.h"
+
+struct FAssetData;
+
+/**
+ * Per-Blueprint dashboard results persisted across editor sessions.
+ *
+ * Each record is keyed by package name and remembers the package saved-hash from the asset
+ * registry plus the settings scoring hash it was computed with. A lookup only hits when both
+ * still match, so unchanged assets never have to be loaded again to be listed, and any save
+ * falls back to a rescan. Records also keep the feature vector of every entry and the settings
+ * feature hash, so a change that only touches the weights re-weights the cached features
+ * instead of rescanning. When calls are weighted by their callee, a record also remembers the
+ * saved-hash of every package its callees live in, and a lookup misses once any of them changed.
+ * The file is a small versioned binary blob under Saved/BpCognitiveComplexity/.
+ */
+class FCognitiveComplexityResultCache
+{
+public:
+	explicit FCognitiveComplexityResultCache(FString InFilePath = GetDefaultFilePath());
+
+	static FString GetDefaultFilePath();
+
+	/** Replaces the in-memory records with the file contents. Returns false if the file is missing, stale or corrupt. */
+	bool Load();
+
+	/** Writes the records to disk if anything changed since the last Load or Save. */
+	bool Save();
+
+	/**
+	 * Returns the cached result if the package and the packages of its callees are unchanged on disk
+	 * and it was scored with these settings, or, if only the weights differ, the cached result
+	 * re-weighted with Weights.
+	 */
+	bool Find(const FAssetData& AssetData, uint32 SettingsHash, uint32 FeatureHash, const FCognitiveComplexityWeights& Weights, FCognitiveComplexityBlueprintResult& OutResult) const;
+
+	/**
+	 * Remembers a freshly computed result whose scores include the callees in CalleePackages. Results
+	 * depending on a package with unsaved edits are skipped, its saved-hash does not describe it.
+	 */
+	void Store(const FCognitiveComplexityBlueprintResult& Result, uint32 SettingsHash, uint32 FeatureHash, TConstArrayView<FName> CalleePackages = {});
+
+	int32 Num() const { return Records.Num(); }
+
+private:
+	struct FRecord
+	{
+		FIoHash PackageSavedHash;
+		uint32 SettingsHash = 0;
+		uint32 FeatureHash = 0;
+		FCognitiveComplexityBlueprintResult Result;
+
+		/** Saved-hash of each package a callee of the Blueprint lives in. */
+		TArray<TPair<FName, FIoHash>> CalleePackageHashes;
+	};
+
+	/** Saved-hash of the package on disk, or false if it is unknown or the in-memory package has unsaved edits. */
+	static bool GetPackageSavedHash(FName PackageName, FIoHash& OutHash);
+
+	FString FilePath;
+	TMap<FName, FRecord> Records;
+	bool bDirty = false;
+};
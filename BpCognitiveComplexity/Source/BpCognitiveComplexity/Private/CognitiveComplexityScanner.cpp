@@ -0,0 +1,365 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityScanner.h"
+
+#include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityAssetTags.h"
+#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityResultCache.h"
+#include "CognitiveComplexitySnapshot.h"
+#include "CognitiveComplexityStats.h"
+#include "BpCognitiveComplexity.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/GarbageCollection.h"
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+DEFINE_STAT(STAT_BpCognitiveComplexity_AssetsLoaded);
+DEFINE_STAT(STAT_BpCognitiveComplexity_ScannerTick);
+
+namespace CognitiveComplexityScanner
+{
+	/** Upper bound on package loads that have been requested but have not landed yet. */
+	static constexpr int32 MaxLoadsInFlight = 16;
+
+	/** Game-thread time spent capturing loaded Blueprints per tick, in seconds. */
+	static constexpr double CaptureBudgetSeconds = 0.008;
+}
+
+FCognitiveComplexityScanner::~FCognitiveComplexityScanner()
+{
+	Cancel();
+}
+
+void FCognitiveComplexityScanner::Start(TArray<FAssetData> InAssets)
+{
+	check(IsInGameThread());
+
+	// A scanner runs once; callers create a fresh one to rescan so late load callbacks
+	// from a previous run can never be mistaken for the current one.
+	if (!ensure(!IsRunning() && NumTotal == 0))
+	{
+		return;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	SampleMemory();
+
+	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+	if (Settings != nullptr)
+	{
+		SettingsHash = Settings->GetScoringHash();
+		FeatureHash = Settings->GetFeatureHash();
+		Weights = Settings->GetWeights();
+	}
+
+	// Results that need no load are handed out on the first tick: the result cache first, since it
+	// holds every entry, then the asset registry tags of unloaded Blueprints. Loaded Blueprints
+	// are always scored; unloaded ones without a usable result are only loaded if asked to.
+	for (FAssetData& AssetData : InAssets)
+	{
+		const bool bIsLoaded = AssetData.IsAssetLoaded();
+
+		FCognitiveComplexityBlueprintResult Result;
+		if ((ResultCache.IsValid() && ResultCache->Find(AssetData, SettingsHash, FeatureHash, Weights, Result))
+			|| (!bIsLoaded && Settings != nullptr && FCognitiveComplexityAssetTags::ReadResult(AssetData, *Settings, Result)))
+		{
+			CachedResults.Add(MoveTemp(Result));
+		}
+		else if (bIsLoaded || bLoadUnloadedAssets)
+		{
+			PendingAssets.Add(MoveTemp(AssetData));
+		}
+		else
+		{
+			++NumUnscored;
+		}
+	}
+
+	NumCached = CachedResults.Num();
+	NumCompleted = NumCached;
+	NumTotal = NumCached + PendingAssets.Num();
+
+	bStreaming = Settings != nullptr && Settings->bStreamingScan;
+	BatchSize = bStreaming ? FMath::Max(1, Settings->ScanBatchSize) : FMath::Max(1, PendingAssets.Num());
+	BatchEnd = FMath::Min(BatchSize, PendingAssets.Num());
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FCognitiveComplexityScanner::Tick));
+}
+
+void FCognitiveComplexityScanner::Cancel()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	PendingAssets.Reset();
+	LoadedBlueprints.Reset();
+	CachedResults.Reset();
+
+	// Left for the editor's next garbage collection.
+	ReleaseBatchPackages();
+
+	// Snapshots own everything they score, so running tasks finish on their own and their results are dropped.
+	PendingScores.Reset();
+	NextPendingIndex = 0;
+
+	// Keep whatever was scored before the cancel.
+	if (ResultCache.IsValid())
+	{
+		ResultCache->Save();
+	}
+}
+
+bool FCognitiveComplexityScanner::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BpCognitiveComplexity_ScannerTick);
+
+	RequestLoads();
+
+	TArray<FCognitiveComplexityBlueprintResult> Results = MoveTemp(CachedResults);
+
+	CollectScores(Results);
+	CaptureLoadedBlueprints();
+
+	if (Results.Num() > 0)
+	{
+		OnResults.ExecuteIfBound(Results);
+	}
+
+	SampleMemory();
+
+	if (NextPendingIndex >= BatchEnd && NumInFlight == 0 && LoadedBlueprints.Num() == 0)
+	{
+		if (bStreaming && BatchPackages.Num() > 0)
+		{
+			// Every Blueprint of the batch has been captured and the snapshots hold no UObjects,
+			// so the packages this scan loaded can be released while they are still being scored.
+			ReleaseBatchPackages();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			++NumGarbageCollections;
+		}
+
+		if (BatchEnd >= PendingAssets.Num())
+		{
+			if (PendingScores.Num() > 0)
+			{
+				return true;
+			}
+
+			Finish();
+			return false;
+		}
+
+		BatchEnd = FMath::Min(BatchEnd + BatchSize, PendingAssets.Num());
+	}
+
+	return true;
+}
+
+void FCognitiveComplexityScanner::CaptureLoadedBlueprints()
+{
+	if (LoadedBlueprints.Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityScanner::CaptureLoadedBlueprints);
+
+	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+	const double Deadline = FPlatformTime::Seconds() + CognitiveComplexityScanner::CaptureBudgetSeconds;
+	int32 NumCaptured = 0;
+
+	// Always capture at least one Blueprint per tick so a huge asset cannot stall the scan.
+	do
+	{
+		FLoadedBlueprint& Loaded = LoadedBlueprints[NumCaptured++];
+
+		if (Settings == nullptr || !Loaded.Blueprint.IsValid())
+		{
+			++NumCompleted;
+			continue;
+		}
+
+		FCognitiveComplexityCalculator Calculator(*Settings);
+		Calculator.SetCallGraph(&CallGraph);
+
+		// The calculator copies the settings it scores with, and the snapshot holds no UObjects,
+		// so the task needs nothing from the game thread. The strong reference is released below.
+		FCognitiveComplexitySnapshot Snapshot = Calculator.CaptureBlueprint(Loaded.Blueprint.Get());
+		TArray<FName> CalleePackages = Snapshot.CalleePackages;
+		PendingScores.Add({ MoveTemp(Loaded.AssetData), MoveTemp(CalleePackages), UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Calculator, Snapshot = MoveTemp(Snapshot)]() mutable
+			{
+				Calculator.ResolveCallees(Snapshot);
+
+				FScoredSnapshot Scored;
+				Scored.Entries = Calculator.ProcessSnapshot(Snapshot);
+				Scored.ResolvedCallees = MoveTemp(Snapshot.ResolvedCallees);
+				return Scored;
+			}) });
+	}
+	while (NumCaptured < LoadedBlueprints.Num() && FPlatformTime::Seconds() < Deadline);
+
+	LoadedBlueprints.RemoveAt(0, NumCaptured);
+}
+
+void FCognitiveComplexityScanner::CollectScores(TArray<FCognitiveComplexityBlueprintResult>& OutResults)
+{
+	for (int32 Index = 0; Index < PendingScores.Num(); ++Index)
+	{
+		FPendingScore& Pending = PendingScores[Index];
+		if (!Pending.Task.IsCompleted())
+		{
+			continue;
+		}
+
+		++NumCompleted;
+
+		FCognitiveComplexityBlueprintResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.BlueprintName = Pending.AssetData.AssetName.ToString();
+		Result.BlueprintPath = Pending.AssetData.PackagePath.ToString();
+		Result.PackageName = Pending.AssetData.PackageName;
+
+		// Later Blueprints calling the same functions and macros reuse their scores.
+		FScoredSnapshot& Scored = Pending.Task.GetResult();
+		CallGraph.Adopt(Scored.ResolvedCallees);
+		Result.Entries = MoveTemp(Scored.Entries);
+
+		if (ResultCache.IsValid())
+		{
+			ResultCache->Store(Result, SettingsHash, FeatureHash, Pending.CalleePackages);
+		}
+
+		PendingScores.RemoveAt(Index--, 1, EAllowShrinking::No);
+	}
+}
+
+void FCognitiveComplexityScanner::ReleaseBatchPackages()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityScanner::ReleaseBatchPackages);
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+
+	// Loaded assets are RF_Standalone, which a KEEPFLAGS collection in the editor never reclaims.
+	// Packages the user opened or edited since the scan loaded them stay.
+	for (const TWeakObjectPtr<UPackage>& WeakPackage : BatchPackages)
+	{
+		UPackage* Package = WeakPackage.Get();
+		if (Package == nullptr || Package->IsDirty())
+		{
+			continue;
+		}
+
+		bool bOpenInEditor = false;
+		ForEachObjectWithPackage(Package, [AssetEditorSubsystem, &bOpenInEditor](UObject* Object)
+		{
+			bOpenInEditor = AssetEditorSubsystem != nullptr && AssetEditorSubsystem->FindEditorForAsset(Object, /*bFocusIfOpen*/false) != nullptr;
+			return !bOpenInEditor;
+		}, /*bIncludeNestedObjects*/false);
+
+		if (!bOpenInEditor)
+		{
+			ForEachObjectWithPackage(Package, [](UObject* Object)
+			{
+				Object->ClearFlags(RF_Standalone);
+				return true;
+			});
+		}
+	}
+
+	BatchPackages.Reset();
+}
+
+void FCognitiveComplexityScanner::SampleMemory()
+{
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, static_cast<uint64>(FPlatformMemory::GetStats().UsedPhysical));
+}
+
+void FCognitiveComplexityScanner::RequestLoads()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityScanner::RequestLoads);
+
+	while (NumInFlight < CognitiveComplexityScanner::MaxLoadsInFlight && NextPendingIndex < BatchEnd)
+	{
+		const FAssetData& AssetData = PendingAssets[NextPendingIndex++];
+
+		// Already in memory: no load needed, just queue it for scoring.
+		if (AssetData.IsAssetLoaded())
+		{
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset()))
+			{
+				LoadedBlueprints.Add({ AssetData, TStrongObjectPtr<UBlueprint>(Blueprint) });
+			}
+			else
+			{
+				++NumCompleted;
+			}
+			continue;
+		}
+
+		++NumInFlight;
+		LoadPackageAsync(
+			AssetData.PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateSP(this, &FCognitiveComplexityScanner::OnPackageLoaded, AssetData));
+	}
+}
+
+void FCognitiveComplexityScanner::OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result, FAssetData AssetData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityScanner::OnPackageLoaded);
+
+	--NumInFlight;
+
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = nullptr;
+	if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage != nullptr)
+	{
+		Blueprint = FindObject<UBlueprint>(LoadedPackage, *AssetData.AssetName.ToString());
+	}
+
+	if (Blueprint == nullptr)
+	{
+		++NumCompleted;
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_BpCognitiveComplexity_AssetsLoaded);
+
+	// Hold a strong reference until the Blueprint has been captured so GC cannot collect it in between.
+	// Only unloaded assets are requested, so the package is this scan's to release after the batch.
+	BatchPackages.Add(LoadedPackage);
+	LoadedBlueprints.Add({ MoveTemp(AssetData), TStrongObjectPtr<UBlueprint>(Blueprint) });
+}
+
+void FCognitiveComplexityScanner::Finish()
+{
+	if (IsRunning())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	PendingAssets.Reset();
+
+	if (ResultCache.IsValid())
+	{
+		ResultCache->Save();
+	}
+
+	UE_LOG(LogBpCognitiveComplexity, Display, TEXT("Scanned %d Blueprints (%d cached) in %.1f s, peak memory %.0f MB, %d garbage collections, %d callees scored."),
+		NumCompleted, NumCached, FPlatformTime::Seconds() - StartTime, PeakUsedPhysical / (1024.0 * 1024.0), NumGarbageCollections, CallGraph.GetNumResolved());
+
+	OnFinished.ExecuteIfBound();
+}
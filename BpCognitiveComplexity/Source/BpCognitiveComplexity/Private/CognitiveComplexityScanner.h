@@ -0,0 +1,144 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityTypes.h"
+#include "Containers/Ticker.h"
+#include "Engine/Blueprint.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+
+class FCognitiveComplexityResultCache;
+class UPackage;
+
+/**
+ * Scores a list of Blueprint assets without blocking the editor.
+ *
+ * Packages are requested through LoadPackageAsync with a bounded number of loads in
+ * flight. Loaded Blueprints are captured into immutable snapshots from a core ticker under
+ * a per-frame time budget and released right away; the snapshots are scored on the task
+ * graph, and finished results are collected on the next ticks. Results are handed back in
+ * small batches as they become available so the caller can stream them into its UI.
+ *
+ * Assets whose saved package is unchanged since they were last scored are answered on the
+ * first tick without loading them at all, from the result cache if one is attached or else
+ * from the complexity tags written into the asset registry on save. Unloaded assets with
+ * neither are skipped unless SetLoadUnloadedAssets(true) was called.
+ *
+ * In streaming mode (the default, see UBpCognitiveComplexitySettings::bStreamingScan) the
+ * remaining assets are processed in batches: a batch is loaded and captured, only the result
+ * rows are kept, and the packages the batch loaded are released and garbage is collected
+ * before the next batch starts loading, so peak memory depends on the batch size rather than
+ * on the size of the project.
+ */
+class FCognitiveComplexityScanner : public TSharedFromThis<FCognitiveComplexityScanner>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnResults, const TArray<FCognitiveComplexityBlueprintResult>& /*Results*/);
+	DECLARE_DELEGATE(FOnFinished);
+
+	~FCognitiveComplexityScanner();
+
+	/** Answers unchanged assets from this cache and stores fresh results into it. Set before Start. */
+	void SetResultCache(TSharedPtr<FCognitiveComplexityResultCache> InResultCache) { ResultCache = MoveTemp(InResultCache); }
+
+	/** Whether unloaded assets without a cached or tagged result get loaded and scored. Set before Start. */
+	void SetLoadUnloadedAssets(bool bInLoadUnloadedAssets) { bLoadUnloadedAssets = bInLoadUnloadedAssets; }
+
+	/** Starts scanning the given assets. Must be called on the game thread. */
+	void Start(TArray<FAssetData> InAssets);
+
+	/** Stops issuing loads and scoring; outstanding loads are ignored when they land. */
+	void Cancel();
+
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+	int32 GetNumTotal() const { return NumTotal; }
+	int32 GetNumCompleted() const { return NumCompleted; }
+	int32 GetNumCached() const { return NumCached; }
+
+	/** Unloaded assets that were skipped because no result was available without loading them. */
+	int32 GetNumUnscored() const { return NumUnscored; }
+
+	/** Highest physical memory use of the process observed while scanning, in bytes. */
+	uint64 GetPeakUsedPhysical() const { return PeakUsedPhysical; }
+	float GetProgress() const { return NumTotal > 0 ? static_cast<float>(NumCompleted) / static_cast<float>(NumTotal) : 1.0f; }
+
+	FOnResults OnResults;
+	FOnFinished OnFinished;
+
+private:
+	struct FLoadedBlueprint
+	{
+		FAssetData AssetData;
+		TStrongObjectPtr<UBlueprint> Blueprint;
+	};
+
+	/** What scoring a snapshot on the task graph hands back. */
+	struct FScoredSnapshot
+	{
+		TArray<FCognitiveComplexityEntryResult> Entries;
+
+		/** Callee scores the task resolved, memoized in CallGraph once they land. */
+		FCognitiveComplexityResolvedCallees ResolvedCallees;
+	};
+
+	/** A Blueprint whose snapshot is being scored on the task graph. */
+	struct FPendingScore
+	{
+		FAssetData AssetData;
+
+		/** Packages the scores depend on through callees, for the result cache. */
+		TArray<FName> CalleePackages;
+
+		UE::Tasks::TTask<FScoredSnapshot> Task;
+	};
+
+	bool Tick(float DeltaTime);
+	void CaptureLoadedBlueprints();
+	void CollectScores(TArray<FCognitiveComplexityBlueprintResult>& OutResults);
+	void RequestLoads();
+	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result, FAssetData AssetData);
+	void Finish();
+	void SampleMemory();
+	void ReleaseBatchPackages();
+
+	TSharedPtr<FCognitiveComplexityResultCache> ResultCache;
+
+	/** Callee scores shared by every Blueprint of the scan when calls are weighted by their callee. */
+	FCognitiveComplexityCallGraph CallGraph;
+	uint32 SettingsHash = 0;
+
+	/** Lets the result cache re-weight records that were counted the same way but scored with other weights. */
+	uint32 FeatureHash = 0;
+	FCognitiveComplexityWeights Weights;
+
+	bool bLoadUnloadedAssets = false;
+
+	TArray<FAssetData> PendingAssets;
+	TArray<FLoadedBlueprint> LoadedBlueprints;
+	TArray<FPendingScore> PendingScores;
+	TArray<FCognitiveComplexityBlueprintResult> CachedResults;
+	FTSTicker::FDelegateHandle TickerHandle;
+	int32 NextPendingIndex = 0;
+	int32 NumInFlight = 0;
+	int32 NumTotal = 0;
+	int32 NumCompleted = 0;
+	int32 NumCached = 0;
+	int32 NumUnscored = 0;
+
+	/** Loads are only issued for PendingAssets[0 .. BatchEnd); the window advances once a batch is fully scored. */
+	bool bStreaming = false;
+	int32 BatchSize = 0;
+	int32 BatchEnd = 0;
+
+	/** Packages this scan loaded itself during the current batch, released before the batch's garbage collection. */
+	TArray<TWeakObjectPtr<UPackage>> BatchPackages;
+	int32 NumGarbageCollections = 0;
+
+	double StartTime = 0.0;
+	uint64 PeakUsedPhysical = 0;
+};
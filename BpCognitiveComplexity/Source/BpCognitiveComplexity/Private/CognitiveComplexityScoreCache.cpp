@@ -0,0 +1,618 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexityScoreCache.h"
+
+#include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityNodeClassifier.h"
+#include "CognitiveComplexitySnapshot.h"
+#include "CognitiveComplexityStats.h"
+#include "Async/Async.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphSchema_K2.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_STAT(STAT_BpCognitiveComplexity_CacheHits);
+DEFINE_STAT(STAT_BpCognitiveComplexity_CacheMisses);
+
+namespace CognitiveComplexityScoreCache
+{
+	/** Game-thread time spent capturing queued graphs per tick, in seconds. */
+	static constexpr double CaptureBudgetSeconds = 0.004;
+
+	/** Buckets looked up within this many frames are still on screen and are never evicted. */
+	static constexpr uint64 RecentlyUsedFrames = 8;
+
+	/** Whether a graph is a Blueprint's K2 graph, the only kind this cache or the call graph scores. */
+	static bool IsBlueprintGraph(const UEdGraph* Graph)
+	{
+		const UEdGraphSchema* Schema = Graph ? Graph->GetSchema() : nullptr;
+		return Schema != nullptr && Schema->IsA<UEdGraphSchema_K2>() && Graph->GetTypedOuter<UBlueprint>() != nullptr;
+	}
+}
+
+FCognitiveComplexityScoreCache::FCognitiveComplexityScoreCache()
+{
+	// Pin link/unlink goes through UObject::Modify on both owning nodes, which is the only
+	// notification we get for relinks; add/remove node arrives through the graph delegate.
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FCognitiveComplexityScoreCache::HandleObjectModified);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCognitiveComplexityScoreCache::HandlePostGarbageCollect);
+}
+
+FCognitiveComplexityScoreCache::~FCognitiveComplexityScoreCache()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	Reset();
+}
+
+TOptional<FCognitiveComplexityScore> FCognitiveComplexityScoreCache::GetScore(const UEdGraphNode& EntryNode)
+{
+	UEdGraph* Graph = EntryNode.GetGraph();
+	if (Graph == nullptr)
+	{
+		return {};
+	}
+
+	const FGraphState& State = FindOrAddGraphState(Graph);
+
+	TOptional<FCognitiveComplexityScore> LastScore;
+	if (const FCachedScore* Cached = State.Entries.Find(EntryNode.NodeGuid))
+	{
+		if (IsUpToDate(*Cached, State))
+		{
+			INC_DWORD_STAT(STAT_BpCognitiveComplexity_CacheHits);
+			return Cached->Score;
+		}
+
+		LastScore = Cached->Score;
+	}
+
+	INC_DWORD_STAT(STAT_BpCognitiveComplexity_CacheMisses);
+
+	// Keep showing the last score until the rescore lands rather than blocking the paint on it.
+	RequestGraphScores(Graph);
+	return LastScore;
+}
+
+void FCognitiveComplexityScoreCache::RequestGraphScores(UEdGraph* Graph)
+{
+	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+	if (Graph == nullptr || Settings == nullptr)
+	{
+		return;
+	}
+
+	FGraphState& State = FindOrAddGraphState(Graph);
+	const FScoreStamp Stamp = GetStamp(State);
+	if (State.PendingStamp.IsSet() && State.PendingStamp.GetValue() == Stamp)
+	{
+		return;
+	}
+
+	bool bUpToDate = true;
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node && EnumHasAnyFlags(FCognitiveComplexityNodeClassifier::Classify(Node), ECognitiveComplexityNodeCategory::Entry))
+		{
+			const FCachedScore* Cached = State.Entries.Find(Node->NodeGuid);
+			if (Cached == nullptr || !IsUpToDate(*Cached, State))
+			{
+				bUpToDate = false;
+				break;
+			}
+		}
+	}
+
+	if (bUpToDate)
+	{
+		return;
+	}
+
+	FCognitiveComplexityCalculator Calculator(*Settings);
+	Calculator.SetCallGraph(&CallGraph);
+
+	// The capture is the only part that reads the graph; everything after it runs on the task graph.
+	State.PendingStamp = Stamp;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = TWeakPtr<FCognitiveComplexityScoreCache>(AsShared()), WeakGraph = TWeakObjectPtr<UEdGraph>(Graph), Stamp, Calculator, Snapshot = Calculator.CaptureGraph(Graph)]() mutable
+		{
+			Calculator.ResolveCallees(Snapshot);
+
+			// Scored together, so memoized mode condenses the graph once for all of its entries.
+			TArray<TArray<FCognitiveComplexityNodeContribution>> Contributions;
+			const TArray<FCognitiveComplexityScore> Scores = Calculator.CalculateEntries(Snapshot.Graph, Contributions);
+
+			TArray<FScoredEntry> ScoredEntries;
+			ScoredEntries.SetNum(Scores.Num());
+			for (int32 Index = 0; Index < ScoredEntries.Num(); ++Index)
+			{
+				FScoredEntry& Scored = ScoredEntries[Index];
+				Scored.NodeGuid = Snapshot.Graph.NodeGuids[Snapshot.Graph.EntryIndices[Index]];
+				Scored.Score = Scores[Index];
+				Scored.Contributions = MoveTemp(Contributions[Index]);
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, WeakGraph, Stamp, ScoredEntries = MoveTemp(ScoredEntries), ResolvedCallees = MoveTemp(Snapshot.ResolvedCallees)]() mutable
+			{
+				if (TSharedPtr<FCognitiveComplexityScoreCache> This = WeakThis.Pin())
+				{
+					This->CallGraph.Adopt(ResolvedCallees);
+					This->AdoptGraphScores(WeakGraph, Stamp, MoveTemp(ScoredEntries));
+				}
+			});
+		});
+}
+
+void FCognitiveComplexityScoreCache::QueueBlueprintScores(const UBlueprint* Blueprint)
+{
+	// A Blueprint without a bucket was never painted, so it has no badges to refresh.
+	FBlueprintBucket* Bucket = Blueprint ? Buckets.Find(TWeakObjectPtr<const UBlueprint>(Blueprint)) : nullptr;
+	if (Bucket == nullptr)
+	{
+		return;
+	}
+
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphState>& Pair : Bucket->Graphs)
+	{
+		if (!Pair.Value.bQueued && Pair.Key.IsValid())
+		{
+			Pair.Value.bQueued = true;
+			QueuedGraphs.Add(Pair.Key);
+		}
+	}
+
+	if (!QueueTickerHandle.IsValid() && QueuedGraphs.Num() > 0)
+	{
+		QueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FCognitiveComplexityScoreCache::TickQueuedGraphs));
+	}
+}
+
+bool FCognitiveComplexityScoreCache::TickQueuedGraphs(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityScoreCache::TickQueuedGraphs);
+
+	const double Deadline = FPlatformTime::Seconds() + CognitiveComplexityScoreCache::CaptureBudgetSeconds;
+	int32 NumRequested = 0;
+
+	// Always capture at least one graph per tick so a huge graph cannot stall the queue.
+	do
+	{
+		// Graphs whose bucket was dropped since they were queued have nothing left to refresh.
+		UEdGraph* Graph = QueuedGraphs[NumRequested++].Get();
+		if (FGraphState* State = FindGraphState(Graph))
+		{
+			State->bQueued = false;
+			RequestGraphScores(Graph);
+		}
+	}
+	while (NumRequested < QueuedGraphs.Num() && FPlatformTime::Seconds() < Deadline);
+
+	QueuedGraphs.RemoveAt(0, NumRequested);
+	if (QueuedGraphs.Num() > 0)
+	{
+		return true;
+	}
+
+	QueueTickerHandle.Reset();
+	return false;
+}
+
+void FCognitiveComplexityScoreCache::AdoptGraphScores(TWeakObjectPtr<UEdGraph> WeakGraph, const FScoreStamp& Stamp, TArray<FScoredEntry> ScoredEntries)
+{
+	UEdGraph* Graph = WeakGraph.Get();
+	if (Graph == nullptr)
+	{
+		return;
+	}
+
+	// Dropped while it was scored, e.g. its editor closed or it was evicted.
+	const TWeakObjectPtr<const UBlueprint> Key(Graph->GetTypedOuter<UBlueprint>());
+	FBlueprintBucket* Bucket = Buckets.Find(Key);
+	FGraphState* State = Bucket ? Bucket->Graphs.Find(Graph) : nullptr;
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	if (State->PendingStamp.IsSet() && State->PendingStamp.GetValue() == Stamp)
+	{
+		State->PendingStamp.Reset();
+	}
+
+	// Edited, recompiled or re-weighted while it was scored: those results may already be wrong.
+	if (!(GetStamp(*State) == Stamp))
+	{
+		if (!State->PendingStamp.IsSet())
+		{
+			RequestGraphScores(Graph);
+		}
+		return;
+	}
+
+	TSet<FGuid> ScoredGuids;
+	ScoredGuids.Reserve(ScoredEntries.Num());
+	int32 NumNodesDelta = 0;
+
+	for (FScoredEntry& Scored : ScoredEntries)
+	{
+		FCachedScore& Entry = State->Entries.FindOrAdd(Scored.NodeGuid);
+		NumNodesDelta += Scored.Contributions.Num() - Entry.Contributions.Num();
+		Entry.Score = Scored.Score;
+		Entry.SettingsGeneration = Stamp.SettingsGeneration;
+		Entry.GraphGeneration = Stamp.GraphGeneration;
+		Entry.Contributions = MoveTemp(Scored.Contributions);
+
+		Entry.ReachedNodeGuids.Reset();
+		Entry.ReachedNodeGuids.Reserve(Entry.Contributions.Num());
+		for (const FCognitiveComplexityNodeContribution& Contribution : Entry.Contributions)
+		{
+			Entry.ReachedNodeGuids.Add(Contribution.NodeGuid);
+		}
+
+		ScoredGuids.Add(Scored.NodeGuid);
+	}
+
+	// Entries that are no longer in the graph were removed since their last score.
+	for (auto It = State->Entries.CreateIterator(); It; ++It)
+	{
+		if (!ScoredGuids.Contains(It.Key()))
+		{
+			NumNodesDelta -= It.Value().Contributions.Num();
+			It.RemoveCurrent();
+		}
+	}
+
+	Bucket->NumNodes += NumNodesDelta;
+	NumCachedNodes += NumNodesDelta;
+	++ContentGeneration;
+
+	// Only adoption grows the cache, so this is the one place that has to enforce the budget.
+	TrimToBudget(Key);
+}
+
+bool FCognitiveComplexityScoreCache::GetNodeContribution(const UEdGraphNode& Node, FCognitiveComplexityNodeContribution& OutContribution, float& OutGraphMaxContribution)
+{
+	UEdGraph* Graph = Node.GetGraph();
+	if (Graph == nullptr)
+	{
+		return false;
+	}
+
+	if (FindOrAddGraphState(Graph).ContributionsGeneration != ContentGeneration)
+	{
+		RebuildNodeContributions(Graph);
+	}
+
+	const FGraphState& State = FindOrAddGraphState(Graph);
+	const FCognitiveComplexityNodeContribution* Contribution = State.NodeContributions.Find(Node.NodeGuid);
+	if (Contribution == nullptr)
+	{
+		return false;
+	}
+
+	OutContribution = *Contribution;
+	OutGraphMaxContribution = State.MaxContribution;
+	return true;
+}
+
+void FCognitiveComplexityScoreCache::RebuildNodeContributions(UEdGraph* Graph)
+{
+	// Stale entries are rescored in the background and bump the content generation when they land,
+	// which brings us back here; until then the heatmap shows their last contributions.
+	RequestGraphScores(Graph);
+
+	FGraphState& State = FindOrAddGraphState(Graph);
+	State.NodeContributions.Reset();
+	State.MaxContribution = 0.0f;
+
+	for (const TPair<FGuid, FCachedScore>& Pair : State.Entries)
+	{
+		// A node reached from several entries shows the entry that weighs on it the most.
+		for (const FCognitiveComplexityNodeContribution& Contribution : Pair.Value.Contributions)
+		{
+			FCognitiveComplexityNodeContribution* Existing = State.NodeContributions.Find(Contribution.NodeGuid);
+			if (Existing == nullptr || Existing->GetTotal() < Contribution.GetTotal())
+			{
+				State.NodeContributions.Add(Contribution.NodeGuid, Contribution);
+			}
+
+			State.MaxContribution = FMath::Max(State.MaxContribution, Contribution.GetTotal());
+		}
+	}
+
+	State.ContributionsGeneration = ContentGeneration;
+}
+
+void FCognitiveComplexityScoreCache::InvalidateGraph(const UEdGraph* Graph)
+{
+	if (Graph == nullptr)
+	{
+		return;
+	}
+
+	CallGraph.Invalidate(Graph);
+
+	if (FGraphState* State = FindGraphState(Graph))
+	{
+		++State->Generation;
+		++ContentGeneration;
+	}
+}
+
+void FCognitiveComplexityScoreCache::InvalidateBlueprint(const UBlueprint* Blueprint)
+{
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	// Its functions and macros may be callees of Blueprints that are open, painted or not.
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* Graph : Graphs)
+	{
+		CallGraph.Invalidate(Graph);
+	}
+
+	FBlueprintBucket* Bucket = Buckets.Find(TWeakObjectPtr<const UBlueprint>(Blueprint));
+	if (Bucket == nullptr)
+	{
+		return;
+	}
+
+	// Graphs that were never painted have nothing cached to go stale.
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphState>& Pair : Bucket->Graphs)
+	{
+		++Pair.Value.Generation;
+	}
+
+	++ContentGeneration;
+}
+
+void FCognitiveComplexityScoreCache::InvalidateAll()
+{
+	++SettingsGeneration;
+	++ContentGeneration;
+	CallGraph.Reset();
+}
+
+void FCognitiveComplexityScoreCache::DropBlueprint(const UBlueprint* Blueprint)
+{
+	if (Blueprint != nullptr)
+	{
+		DropBucket(TWeakObjectPtr<const UBlueprint>(Blueprint));
+	}
+}
+
+void FCognitiveComplexityScoreCache::DropBucket(const TWeakObjectPtr<const UBlueprint>& Key)
+{
+	FBlueprintBucket* Bucket = Buckets.Find(Key);
+	if (Bucket == nullptr)
+	{
+		return;
+	}
+
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphState>& Pair : Bucket->Graphs)
+	{
+		if (UEdGraph* Graph = Pair.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(Pair.Value.GraphChangedHandle);
+		}
+	}
+
+	// Captures still in flight for these graphs find no state when they land and are dropped.
+	NumCachedNodes -= Bucket->NumNodes;
+	Buckets.Remove(Key);
+	++ContentGeneration;
+}
+
+void FCognitiveComplexityScoreCache::TrimToBudget(const TWeakObjectPtr<const UBlueprint>& KeepKey)
+{
+	const UBpCognitiveComplexitySettings* Settings = UBpCognitiveComplexitySettings::Get();
+	const int32 MaxNodes = Settings ? Settings->ScoreCacheMaxNodes : 0;
+	if (MaxNodes <= 0 || NumCachedNodes <= MaxNodes)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCognitiveComplexityScoreCache::TrimToBudget);
+
+	// There are only as many buckets as Blueprints painted this session, so a scan per eviction is
+	// cheaper than keeping an ordered list up to date on every paint. The bucket that was just
+	// scored and pinned buckets stay even if the budget is exceeded without them.
+	while (NumCachedNodes > MaxNodes)
+	{
+		const TWeakObjectPtr<const UBlueprint>* OldestKey = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<TWeakObjectPtr<const UBlueprint>, FBlueprintBucket>& Pair : Buckets)
+		{
+			if (Pair.Value.LastUsed < OldestUse && Pair.Key != KeepKey && !IsPinned(Pair.Key, Pair.Value))
+			{
+				OldestKey = &Pair.Key;
+				OldestUse = Pair.Value.LastUsed;
+			}
+		}
+
+		if (OldestKey == nullptr)
+		{
+			break;
+		}
+
+		DropBucket(TWeakObjectPtr<const UBlueprint>(*OldestKey));
+	}
+}
+
+bool FCognitiveComplexityScoreCache::IsPinned(const TWeakObjectPtr<const UBlueprint>& Key, const FBlueprintBucket& Bucket) const
+{
+	if (GFrameCounter - Bucket.LastUsedFrame <= CognitiveComplexityScoreCache::RecentlyUsedFrames)
+	{
+		return true;
+	}
+
+	UBlueprint* Blueprint = const_cast<UBlueprint*>(Key.Get());
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	return Blueprint != nullptr && AssetEditorSubsystem != nullptr && AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen*/false) != nullptr;
+}
+
+void FCognitiveComplexityScoreCache::HandlePostGarbageCollect()
+{
+	// Unloaded Blueprints cost memory without ever being painted again.
+	TArray<TWeakObjectPtr<const UBlueprint>, TInlineAllocator<8>> StaleKeys;
+	for (const TPair<TWeakObjectPtr<const UBlueprint>, FBlueprintBucket>& Pair : Buckets)
+	{
+		if (Pair.Key.IsStale())
+		{
+			StaleKeys.Add(Pair.Key);
+		}
+	}
+
+	for (const TWeakObjectPtr<const UBlueprint>& Key : StaleKeys)
+	{
+		DropBucket(Key);
+	}
+}
+
+void FCognitiveComplexityScoreCache::Reset()
+{
+	for (TPair<TWeakObjectPtr<const UBlueprint>, FBlueprintBucket>& BucketPair : Buckets)
+	{
+		for (TPair<TWeakObjectPtr<UEdGraph>, FGraphState>& Pair : BucketPair.Value.Graphs)
+		{
+			if (UEdGraph* Graph = Pair.Key.Get())
+			{
+				Graph->RemoveOnGraphChangedHandler(Pair.Value.GraphChangedHandle);
+			}
+		}
+	}
+
+	if (QueueTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(QueueTickerHandle);
+		QueueTickerHandle.Reset();
+	}
+
+	QueuedGraphs.Empty();
+	Buckets.Empty();
+	NumCachedNodes = 0;
+	CallGraph.Reset();
+	++ContentGeneration;
+}
+
+void FCognitiveComplexityScoreCache::InvalidateEntriesReaching(const UEdGraph* Graph, const FGuid& NodeGuid)
+{
+	// Modify() also runs on material, Niagara and other editor graphs; bumping the call graph
+	// generation for those would discard every callee score still being resolved.
+	if (!CognitiveComplexityScoreCache::IsBlueprintGraph(Graph))
+	{
+		return;
+	}
+
+	// Only the edited graph's callee score and the callee scores including it go stale.
+	CallGraph.Invalidate(Graph);
+
+	FGraphState* State = FindGraphState(Graph);
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	for (TPair<FGuid, FCachedScore>& Pair : State->Entries)
+	{
+		// Keep the score so the badge has something to show until the rescore lands; generation 0
+		// never matches. A capture taken before this edit must not be adopted, even for an entry
+		// that is already stale.
+		if (Pair.Value.ReachedNodeGuids.Contains(NodeGuid))
+		{
+			Pair.Value.GraphGeneration = 0;
+			++State->EditSerial;
+			++ContentGeneration;
+		}
+	}
+}
+
+FCognitiveComplexityScoreCache::FScoreStamp FCognitiveComplexityScoreCache::GetStamp(const FGraphState& State) const
+{
+	return { SettingsGeneration, State.Generation, State.EditSerial };
+}
+
+bool FCognitiveComplexityScoreCache::IsUpToDate(const FCachedScore& Cached, const FGraphState& State) const
+{
+	return Cached.SettingsGeneration == SettingsGeneration && Cached.GraphGeneration == State.Generation;
+}
+
+FCognitiveComplexityScoreCache::FGraphState& FCognitiveComplexityScoreCache::FindOrAddGraphState(UEdGraph* Graph)
+{
+	FBlueprintBucket& Bucket = Buckets.FindOrAdd(TWeakObjectPtr<const UBlueprint>(Graph->GetTypedOuter<UBlueprint>()));
+	Bucket.LastUsed = ++UseClock;
+	Bucket.LastUsedFrame = GFrameCounter;
+
+	if (FGraphState* Existing = Bucket.Graphs.Find(Graph))
+	{
+		return *Existing;
+	}
+
+	// First time we see this graph: listen for edits so its scores go stale with it.
+	FGraphState& State = Bucket.Graphs.Add(Graph);
+	State.GraphChangedHandle = Graph->AddOnGraphChangedHandler(
+		FOnGraphChanged::FDelegate::CreateRaw(this, &FCognitiveComplexityScoreCache::HandleGraphChanged, TWeakObjectPtr<UEdGraph>(Graph)));
+	return State;
+}
+
+FCognitiveComplexityScoreCache::FGraphState* FCognitiveComplexityScoreCache::FindGraphState(const UEdGraph* Graph)
+{
+	if (Graph == nullptr)
+	{
+		return nullptr;
+	}
+
+	FBlueprintBucket* Bucket = Buckets.Find(TWeakObjectPtr<const UBlueprint>(Graph->GetTypedOuter<UBlueprint>()));
+	return Bucket ? Bucket->Graphs.Find(const_cast<UEdGraph*>(Graph)) : nullptr;
+}
+
+void FCognitiveComplexityScoreCache::HandleGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UEdGraph> WeakGraph)
+{
+	// Selection changes do not alter the exec topology.
+	if (Action.Action == GRAPHACTION_SelectNode)
+	{
+		return;
+	}
+
+	const UEdGraph* Graph = WeakGraph.Get();
+
+	// A bare NotifyGraphChanged() does not say what changed, so everything in the graph is suspect.
+	if (Action.Nodes.Num() == 0)
+	{
+		InvalidateGraph(Graph);
+		return;
+	}
+
+	// Freshly added nodes are not reachable from any entry until they get linked, and the
+	// link itself is reported through HandleObjectModified; removed nodes drop their entries.
+	for (const UEdGraphNode* Node : Action.Nodes)
+	{
+		if (Node != nullptr)
+		{
+			InvalidateEntriesReaching(Graph, Node->NodeGuid);
+		}
+	}
+}
+
+void FCognitiveComplexityScoreCache::HandleObjectModified(UObject* Object)
+{
+	const UEdGraphNode* Node = Cast<UEdGraphNode>(Object);
+	if (Node == nullptr)
+	{
+		return;
+	}
+
+	// Modify() runs before the edit, so the node's current reach still identifies every
+	// entry the edit can affect; the rescore starts on the next paint.
+	InvalidateEntriesReaching(Node->GetGraph(), Node->NodeGuid);
+}
@@ -0,0 +1,199 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityTypes.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UEdGraph;
+class UEdGraphNode;
+class UBlueprint;
+class UObject;
+struct FEdGraphEditAction;
+
+/**
+ * Per-entry-node score cache used by the graph editor badges.
+ *
+ * Scores are bucketed per Blueprint and graph, keyed by NodeGuid within their graph, and
+ * stamped with two generations: a global settings generation and the generation of the graph
+ * owning the entry. Compiling a Blueprint or changing the settings only bumps counters, so
+ * painting a badge is a few map lookups unless something actually changed.
+ *
+ * A Blueprint's bucket is dropped as a whole when its editor closes, or after the garbage
+ * collection that reclaims the Blueprint. Buckets also remember when they were last painted: once
+ * the cache holds more node contributions than UBpCognitiveComplexitySettings::ScoreCacheMaxNodes,
+ * the least recently used Blueprints are dropped first. Blueprints open in an asset editor or
+ * painted in the last few frames are never dropped for the budget, which may overshoot instead.
+ *
+ * Each entry also remembers which nodes its exec walk reached. Graph and node change
+ * notifications mark only the entries whose reach contains the edited node as stale, so an
+ * edit inside one event leaves every other badge of the graph cached.
+ *
+ * Stale entries are rescored off the game thread: a miss captures an immutable snapshot of the
+ * entry's graph, scores all of its entries on the task graph, and adopts the results on the game
+ * thread once they land, unless the graph was edited in the meantime. Until then GetScore keeps
+ * returning the last score, and nothing before an entry's first score.
+ *
+ * The same walk records what each node contributed. For the heatmap those contributions are
+ * merged per graph into a node lookup table, rebuilt only after a cached score changed.
+ *
+ * When calls are weighted by their callee, callee scores are memoized in a call graph. Callees it
+ * does not know yet are captured with the graph, scored on the task graph and memoized when the
+ * results land. An edit forgets only the edited graph's callee score and the callee scores that
+ * include it. Entries calling an edited function pick up its new score once they are invalidated
+ * themselves, e.g. when their Blueprint is compiled.
+ */
+class FCognitiveComplexityScoreCache : public TSharedFromThis<FCognitiveComplexityScoreCache>
+{
+public:
+	FCognitiveComplexityScoreCache();
+	~FCognitiveComplexityScoreCache();
+
+	/**
+	 * Returns the last score of an entry node, starting a background rescore of its graph if the
+	 * score is stale. Unset until the entry has been scored once.
+	 */
+	TOptional<FCognitiveComplexityScore> GetScore(const UEdGraphNode& EntryNode);
+
+	/** Starts a background rescore of the graph unless its entries are up to date or one is already running. */
+	void RequestGraphScores(UEdGraph* Graph);
+
+	/**
+	 * Queues every graph of the Blueprint that has cached scores for RequestGraphScores. Graphs that
+	 * were never painted are scored on their first paint instead. The queue is drained from a core
+	 * ticker a few graphs per frame, so a compile never waits on capturing its graphs.
+	 */
+	void QueueBlueprintScores(const UBlueprint* Blueprint);
+
+	/**
+	 * Finds the largest contribution any entry of the node's graph attributes to the node, scoring
+	 * the graph's entries first if needed. Also returns the largest contribution in that graph.
+	 */
+	bool GetNodeContribution(const UEdGraphNode& Node, FCognitiveComplexityNodeContribution& OutContribution, float& OutGraphMaxContribution);
+
+	/** Bumped whenever a cached score is adopted or goes stale, so callers caching lookups know when to refresh. */
+	uint32 GetContentGeneration() const { return ContentGeneration; }
+
+	/** Marks every cached score of this graph as stale. */
+	void InvalidateGraph(const UEdGraph* Graph);
+
+	/** Marks every cached score of the Blueprint's graphs as stale. */
+	void InvalidateBlueprint(const UBlueprint* Blueprint);
+
+	/** Marks every cached score as stale, e.g. after the weights changed. */
+	void InvalidateAll();
+
+	/** Drops the Blueprint's cached scores and graph listeners. */
+	void DropBlueprint(const UBlueprint* Blueprint);
+
+	/** Node contributions currently held, which is what ScoreCacheMaxNodes bounds. */
+	int32 GetNumCachedNodes() const { return NumCachedNodes; }
+
+	/** Drops all cached scores and graph listeners. */
+	void Reset();
+
+private:
+	struct FCachedScore
+	{
+		FCognitiveComplexityScore Score;
+		uint32 SettingsGeneration = 0;
+		uint32 GraphGeneration = 0;
+		TArray<FCognitiveComplexityNodeContribution> Contributions;
+		TSet<FGuid> ReachedNodeGuids;
+	};
+
+	/** What a graph's scores were computed against. Results of a capture are only adopted if it still matches. */
+	struct FScoreStamp
+	{
+		uint32 SettingsGeneration = 0;
+		uint32 GraphGeneration = 0;
+		uint32 EditSerial = 0;
+
+		bool operator==(const FScoreStamp& Other) const
+		{
+			return SettingsGeneration == Other.SettingsGeneration && GraphGeneration == Other.GraphGeneration && EditSerial == Other.EditSerial;
+		}
+	};
+
+	/** Score and reach of one entry, computed off the game thread. */
+	struct FScoredEntry
+	{
+		FGuid NodeGuid;
+		FCognitiveComplexityScore Score;
+		TArray<FCognitiveComplexityNodeContribution> Contributions;
+	};
+
+	struct FGraphState
+	{
+		uint32 Generation = 1;
+
+		/** Bumped whenever an entry of the graph goes stale, so scores captured before the edit are dropped. */
+		uint32 EditSerial = 0;
+
+		/** Stamp of the capture being scored, if any. */
+		TOptional<FScoreStamp> PendingStamp;
+
+		/** In QueuedGraphs, so a graph is queued at most once however often its Blueprint compiles. */
+		bool bQueued = false;
+
+		FDelegateHandle GraphChangedHandle;
+		TMap<FGuid, FCachedScore> Entries;
+
+		/** Hottest contribution per node across the graph's entries, built at ContributionsGeneration. */
+		TMap<FGuid, FCognitiveComplexityNodeContribution> NodeContributions;
+		float MaxContribution = 0.0f;
+		uint32 ContributionsGeneration = 0;
+	};
+
+	/** Every cached graph of one Blueprint. */
+	struct FBlueprintBucket
+	{
+		TMap<TWeakObjectPtr<UEdGraph>, FGraphState> Graphs;
+
+		/** UseClock value of the last lookup, for least-recently-used eviction. */
+		uint64 LastUsed = 0;
+
+		/** GFrameCounter at the last lookup. Buckets looked up in the last few frames are never evicted. */
+		uint64 LastUsedFrame = 0;
+
+		/** Node contributions held by the bucket's entries. */
+		int32 NumNodes = 0;
+	};
+
+	/** Finds or adds the graph's state and marks its Blueprint as just used. */
+	FGraphState& FindOrAddGraphState(UEdGraph* Graph);
+	FGraphState* FindGraphState(const UEdGraph* Graph);
+	void DropBucket(const TWeakObjectPtr<const UBlueprint>& Key);
+	void TrimToBudget(const TWeakObjectPtr<const UBlueprint>& KeepKey);
+
+	/** Whether the budget must not evict the bucket: its Blueprint is open in an asset editor or was just painted. */
+	bool IsPinned(const TWeakObjectPtr<const UBlueprint>& Key, const FBlueprintBucket& Bucket) const;
+
+	/** Drops the buckets of Blueprints the collection reclaimed. */
+	void HandlePostGarbageCollect();
+
+	FScoreStamp GetStamp(const FGraphState& State) const;
+	bool IsUpToDate(const FCachedScore& Cached, const FGraphState& State) const;
+	void AdoptGraphScores(TWeakObjectPtr<UEdGraph> WeakGraph, const FScoreStamp& Stamp, TArray<FScoredEntry> ScoredEntries);
+	void RebuildNodeContributions(UEdGraph* Graph);
+	void InvalidateEntriesReaching(const UEdGraph* Graph, const FGuid& NodeGuid);
+	void HandleGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UEdGraph> WeakGraph);
+	void HandleObjectModified(UObject* Object);
+	bool TickQueuedGraphs(float DeltaTime);
+
+	/** Graphs without an owning Blueprint share the bucket of a null key. */
+	TMap<TWeakObjectPtr<const UBlueprint>, FBlueprintBucket> Buckets;
+	uint64 UseClock = 0;
+	int32 NumCachedNodes = 0;
+	uint32 SettingsGeneration = 1;
+	uint32 ContentGeneration = 1;
+	FCognitiveComplexityCallGraph CallGraph;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+
+	TArray<TWeakObjectPtr<UEdGraph>> QueuedGraphs;
+	FTSTicker::FDelegateHandle QueueTickerHandle;
+};
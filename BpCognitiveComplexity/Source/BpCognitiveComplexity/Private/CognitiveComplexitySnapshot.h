@@ -0,0 +1,59 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityFlatGraph.h"
+
+/** A call site whose weight is the score of a callee captured into the snapshot. */
+struct FCognitiveComplexitySnapshotCallSite
+{
+	/** Node of the call site, in the flat graph it belongs to. */
+	int32 NodeIndex = INDEX_NONE;
+
+	/** Index of the called graph in FCognitiveComplexitySnapshot::CalleeEntries. */
+	int32 Callee = INDEX_NONE;
+};
+
+/**
+ * Immutable copy of everything needed to score the entries of some graphs: the flattened exec
+ * and data topology with node categories, GUIDs and callee scores, plus the entry titles.
+ *
+ * Captured on the game thread by FCognitiveComplexityCalculator::CaptureBlueprint or CaptureGraph.
+ * It holds no UObject pointers, so once captured it can be scored on any thread while the user
+ * keeps editing the graphs it was taken from.
+ *
+ * When calls are weighted by their callee, callee scores memoized at capture are copied into
+ * Graph. Every other function and macro graph the call sites reach is flattened into CalleeGraph
+ * instead, and FCognitiveComplexityCalculator::ResolveCallees scores them off the game thread.
+ */
+struct FCognitiveComplexitySnapshot
+{
+	FCognitiveComplexityFlatGraph Graph;
+
+	/** Titles of the entries in Graph.EntryIndices order. Titles go through FText formatting, so they are resolved at capture. */
+	TArray<FString> EntryDisplayNames;
+
+	/** Other packages whose functions and macros the scores include. Only filled when calls are weighted by their callee. */
+	TArray<FName> CalleePackages;
+
+	/** Callee graphs whose scores were not memoized at capture, flattened together. */
+	FCognitiveComplexityFlatGraph CalleeGraph;
+
+	/** Node in CalleeGraph each captured callee is scored from, or INDEX_NONE if it has no entry. */
+	TArray<int32> CalleeEntries;
+
+	/** Call sites in CalleeGraph of captured callee I are CalleeCallSites[CalleeCallSiteOffsets[I] .. CalleeCallSiteOffsets[I + 1]). */
+	TArray<int32> CalleeCallSiteOffsets;
+	TArray<FCognitiveComplexitySnapshotCallSite> CalleeCallSites;
+
+	/** Call sites in Graph whose callee was captured. */
+	TArray<FCognitiveComplexitySnapshotCallSite> PendingCallSites;
+
+	/** Keys of the captured callees, and their scores once resolved, for FCognitiveComplexityCallGraph::Adopt. */
+	FCognitiveComplexityResolvedCallees ResolvedCallees;
+
+	/** Whether ResolveCallees still has to fill in callee scores before the snapshot is scored. */
+	bool HasPendingCallees() const { return CalleeEntries.Num() > 0; }
+};
@@ -0,0 +1,24 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("BpCognitiveComplexity"), STATGROUP_BpCognitiveComplexity, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Score Cache Hits"), STAT_BpCognitiveComplexity_CacheHits, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Score Cache Misses"), STAT_BpCognitiveComplexity_CacheMisses, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Badge Layout Rebuilds"), STAT_BpCognitiveComplexity_BadgeLayoutRebuilds, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Heatmap Layout Rebuilds"), STAT_BpCognitiveComplexity_HeatLayoutRebuilds, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Result Cache Hits"), STAT_BpCognitiveComplexity_ResultCacheHits, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Entries Scored"), STAT_BpCognitiveComplexity_EntriesScored, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Visited"), STAT_BpCognitiveComplexity_NodesVisited, STATGROUP_BpCognitiveComplexity, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Assets Loaded"), STAT_BpCognitiveComplexity_AssetsLoaded, STATGROUP_BpCognitiveComplexity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Process Blueprint"), STAT_BpCognitiveComplexity_ProcessBlueprint, STATGROUP_BpCognitiveComplexity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Score Entries"), STAT_BpCognitiveComplexity_ScoreEntries, STATGROUP_BpCognitiveComplexity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scanner Tick"), STAT_BpCognitiveComplexity_ScannerTick, STATGROUP_BpCognitiveComplexity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dashboard Refresh"), STAT_BpCognitiveComplexity_DashboardRefresh, STATGROUP_BpCognitiveComplexity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Badge Paint"), STAT_BpCognitiveComplexity_BadgePaint, STATGROUP_BpCognitiveComplexity, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Heatmap Paint"), STAT_BpCognitiveComplexity_HeatmapPaint, STATGROUP_BpCognitiveComplexity, );
@@ -0,0 +1,315 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "CognitiveComplexitySyntheticGraph.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_SwitchInteger.h"
+#include "K2Node_Timeline.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/Package.h"
+
+namespace CognitiveComplexitySyntheticGraph
+{
+	static const FName SyntheticGraphName(TEXT("CognitiveComplexitySynthetic"));
+
+	static void BuildChain(UEdGraph* Graph, UEdGraphNode* Entry, int32 NumNodes)
+	{
+		UEdGraphNode* Previous = Entry;
+		for (int32 Index = 1; Index < NumNodes; ++Index)
+		{
+			UEdGraphNode* Call = FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_CallFunction::StaticClass(), true, 1);
+			FCognitiveComplexitySyntheticGraph::Link(Previous, 0, Call);
+			Previous = Call;
+		}
+	}
+
+	static void BuildBranchNest(UEdGraph* Graph, UEdGraphNode* Entry, int32 NumNodes)
+	{
+		UEdGraphNode* Previous = Entry;
+		for (int32 Index = 1; Index + 1 < NumNodes; Index += 2)
+		{
+			UEdGraphNode* Branch = FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_IfThenElse::StaticClass(), true, 2);
+			UEdGraphNode* ElseCall = FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_CallFunction::StaticClass(), true, 1);
+			FCognitiveComplexitySyntheticGraph::Link(Previous, 0, Branch);
+			FCognitiveComplexitySyntheticGraph::Link(Branch, 1, ElseCall);
+			Previous = Branch;
+		}
+	}
+
+	static void BuildMixed(UEdGraph* Graph, UEdGraphNode* Entry, int32 NumNodes)
+	{
+		UClass* const NodeClasses[] =
+		{
+			UK2Node_CallFunction::StaticClass(),
+			UK2Node_IfThenElse::StaticClass(),
+			UK2Node_ExecutionSequence::StaticClass(),
+			UK2Node_SwitchInteger::StaticClass(),
+			UK2Node_Timeline::StaticClass(),
+		};
+
+		UEdGraphNode* Previous = Entry;
+		for (int32 Index = 1; Index < NumNodes; ++Index)
+		{
+			UEdGraphNode* Node = FCognitiveComplexitySyntheticGraph::AddNode(Graph, NodeClasses[Index % UE_ARRAY_COUNT(NodeClasses)], true, 1);
+			FCognitiveComplexitySyntheticGraph::Link(Previous, 0, Node);
+			Previous = Node;
+		}
+	}
+
+	static void BuildWideSequence(UEdGraph* Graph, UEdGraphNode* Entry, int32 NumNodes)
+	{
+		if (NumNodes < 3)
+		{
+			return;
+		}
+
+		const int32 NumCalls = NumNodes - 2;
+		UEdGraphNode* Sequence = FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_ExecutionSequence::StaticClass(), true, NumCalls);
+		FCognitiveComplexitySyntheticGraph::Link(Entry, 0, Sequence);
+
+		for (int32 Index = 0; Index < NumCalls; ++Index)
+		{
+			FCognitiveComplexitySyntheticGraph::Link(Sequence, Index, FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_CallFunction::StaticClass(), true, 1));
+		}
+	}
+
+	static void BuildSwitchFanOut(UEdGraph* Graph, UEdGraphNode* Entry, int32 NumNodes)
+	{
+		static constexpr int32 NumCases = 16;
+
+		UEdGraphNode* Previous = Entry;
+		int32 PreviousOutput = 0;
+		for (int32 Index = 1; Index + NumCases <= NumNodes; Index += NumCases)
+		{
+			UEdGraphNode* Switch = FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_SwitchInteger::StaticClass(), true, NumCases);
+			FCognitiveComplexitySyntheticGraph::Link(Previous, PreviousOutput, Switch);
+
+			for (int32 Case = 1; Case < NumCases; ++Case)
+			{
+				FCognitiveComplexitySyntheticGraph::Link(Switch, Case, FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_CallFunction::StaticClass(), true, 1));
+			}
+
+			Previous = Switch;
+			PreviousOutput = 0;
+		}
+	}
+
+	static void BuildCyclicLoop(UEdGraph* Graph, UEdGraphNode* Entry, int32 NumNodes)
+	{
+		static constexpr int32 LoopLength = 8;
+
+		TArray<UEdGraphNode*> Calls;
+		Calls.Reserve(NumNodes);
+
+		UEdGraphNode* Previous = Entry;
+		for (int32 Index = 1; Index < NumNodes; ++Index)
+		{
+			UEdGraphNode* Call = FCognitiveComplexitySyntheticGraph::AddNode(Graph, UK2Node_CallFunction::StaticClass(), true, 2);
+			FCognitiveComplexitySyntheticGraph::Link(Previous, 0, Call);
+
+			if (Calls.Num() >= LoopLength)
+			{
+				FCognitiveComplexitySyntheticGraph::Link(Call, 1, Calls[Calls.Num() - LoopLength]);
+			}
+
+			Calls.Add(Call);
+			Previous = Call;
+		}
+	}
+}
+
+UBlueprint* FCognitiveComplexitySyntheticGraph::CreateBlueprint(const FCognitiveComplexitySyntheticGraphParams& Params)
+{
+	using namespace CognitiveComplexitySyntheticGraph;
+
+	UBlueprint* Blueprint = CreateEmptyBlueprint();
+	UEdGraph* Graph = GetGraph(Blueprint);
+	if (Graph == nullptr)
+	{
+		return Blueprint;
+	}
+
+	const int32 NumEntries = FMath::Max(1, Params.NumEntries);
+	const int32 NodesPerEntry = FMath::Max(1, Params.NodesPerEntry);
+	Graph->Nodes.Reserve(NumEntries * NodesPerEntry);
+
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+	{
+		UEdGraphNode* Entry = AddEntry(Graph, EntryIndex);
+
+		switch (Params.Shape)
+		{
+		case ECognitiveComplexitySyntheticShape::Chain:
+			BuildChain(Graph, Entry, NodesPerEntry);
+			break;
+		case ECognitiveComplexitySyntheticShape::BranchNest:
+			BuildBranchNest(Graph, Entry, NodesPerEntry);
+			break;
+		case ECognitiveComplexitySyntheticShape::Mixed:
+			BuildMixed(Graph, Entry, NodesPerEntry);
+			break;
+		case ECognitiveComplexitySyntheticShape::WideSequence:
+			BuildWideSequence(Graph, Entry, NodesPerEntry);
+			break;
+		case ECognitiveComplexitySyntheticShape::SwitchFanOut:
+			BuildSwitchFanOut(Graph, Entry, NodesPerEntry);
+			break;
+		case ECognitiveComplexitySyntheticShape::CyclicLoop:
+			BuildCyclicLoop(Graph, Entry, NodesPerEntry);
+			break;
+		}
+	}
+
+	return Blueprint;
+}
+
+UBlueprint* FCognitiveComplexitySyntheticGraph::CreateEmptyBlueprint()
+{
+	using namespace CognitiveComplexitySyntheticGraph;
+
+	UPackage* Package = GetTransientPackage();
+	const FName BlueprintName = MakeUniqueObjectName(Package, UBlueprint::StaticClass(), TEXT("BpCognitiveComplexitySynthetic"));
+
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+		UObject::StaticClass(), Package, BlueprintName, BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
+	UEdGraph* Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, SyntheticGraphName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	Blueprint->UbergraphPages.Add(Graph);
+
+	return Blueprint;
+}
+
+UEdGraphNode* FCognitiveComplexitySyntheticGraph::AddNode(UEdGraph* Graph, UClass* NodeClass, bool bHasExecInput, int32 NumExecOutputs)
+{
+	UEdGraphNode* Node = NewObject<UEdGraphNode>(Graph, NodeClass, NAME_None, RF_Transactional);
+	Graph->AddNode(Node, /*bFromUI*/false, /*bSelectNewNode*/false);
+	Node->CreateNewGuid();
+
+	if (bHasExecInput)
+	{
+		Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	}
+
+	for (int32 Index = 0; Index < NumExecOutputs; ++Index)
+	{
+		Node->CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, FName(UEdGraphSchema_K2::PN_Then, Index + 1));
+	}
+
+	return Node;
+}
+
+UEdGraphNode* FCognitiveComplexitySyntheticGraph::AddEntry(UEdGraph* Graph, int32 EntryIndex)
+{
+	UK2Node_Event* Event = CastChecked<UK2Node_Event>(AddNode(Graph, UK2Node_Event::StaticClass(), false, 1));
+	// A custom name keeps the title independent of any signature function lookup.
+	Event->CustomFunctionName = FName(TEXT("SyntheticEvent"), EntryIndex + 1);
+	return Event;
+}
+
+void FCognitiveComplexitySyntheticGraph::Link(UEdGraphNode* From, int32 OutputIndex, UEdGraphNode* To)
+{
+	// Inputs are created before outputs, so output N sits right after the optional exec input.
+	const int32 FirstOutput = From->Pins.Num() > 0 && From->Pins[0]->Direction == EGPD_Input ? 1 : 0;
+	From->Pins[FirstOutput + OutputIndex]->MakeLinkTo(To->Pins[0]);
+}
+
+void FCognitiveComplexitySyntheticGraph::LinkData(UEdGraphNode* From, UEdGraphNode* To)
+{
+	UEdGraphPin* Output = From->CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Int, NAME_None);
+	UEdGraphPin* Input = To->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, NAME_None);
+	Output->MakeLinkTo(Input);
+}
+
+void FCognitiveComplexitySyntheticGraph::DestroyBlueprint(UBlueprint* Blueprint)
+{
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	Blueprint->ClearFlags(RF_Public | RF_Standalone);
+	Blueprint->MarkAsGarbage();
+}
+
+UEdGraph* FCognitiveComplexitySyntheticGraph::GetGraph(const UBlueprint* Blueprint)
+{
+	if (Blueprint == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	{
+		if (Graph && Graph->GetFName() == CognitiveComplexitySyntheticGraph::SyntheticGraphName)
+		{
+			return Graph;
+		}
+	}
+
+	return nullptr;
+}
+
+TArray<const UEdGraphNode*> FCognitiveComplexitySyntheticGraph::GetEntryNodes(const UBlueprint* Blueprint)
+{
+	TArray<const UEdGraphNode*> EntryNodes;
+
+	if (const UEdGraph* Graph = GetGraph(Blueprint))
+	{
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && Node->IsA<UK2Node_Event>())
+			{
+				EntryNodes.Add(Node);
+			}
+		}
+	}
+
+	return EntryNodes;
+}
+
+bool FCognitiveComplexitySyntheticGraph::ParseShape(const FString& InString, ECognitiveComplexitySyntheticShape& OutShape)
+{
+	for (const ECognitiveComplexitySyntheticShape Shape : AllSyntheticShapes)
+	{
+		if (InString.Equals(ShapeToString(Shape), ESearchCase::IgnoreCase))
+		{
+			OutShape = Shape;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TCHAR* FCognitiveComplexitySyntheticGraph::ShapeToString(ECognitiveComplexitySyntheticShape Shape)
+{
+	switch (Shape)
+	{
+	case ECognitiveComplexitySyntheticShape::Chain:
+		return TEXT("Chain");
+	case ECognitiveComplexitySyntheticShape::BranchNest:
+		return TEXT("BranchNest");
+	case ECognitiveComplexitySyntheticShape::Mixed:
+		return TEXT("Mixed");
+	case ECognitiveComplexitySyntheticShape::WideSequence:
+		return TEXT("WideSequence");
+	case ECognitiveComplexitySyntheticShape::SwitchFanOut:
+		return TEXT("SwitchFanOut");
+	case ECognitiveComplexitySyntheticShape::CyclicLoop:
+		return TEXT("CyclicLoop");
+	}
+	return TEXT("Unknown");
+}
@@ -0,0 +1,86 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UClass;
+class UEdGraph;
+class UEdGraphNode;
+
+enum class ECognitiveComplexitySyntheticShape : uint8
+{
+	/** Each event runs a straight line of function calls. */
+	Chain,
+	/** Each event runs a Branch nested in the previous Branch's Then pin, with a call on every Else. */
+	BranchNest,
+	/** Each event runs a straight line cycling through call, branch, sequence, switch and timeline nodes. */
+	Mixed,
+	/** Each event runs one Sequence node with a call on every output. */
+	WideSequence,
+	/** Each event runs a chain of 16-way switches, the first case continuing the chain and every other case running a call. */
+	SwitchFanOut,
+	/** Each event runs a chain of calls whose second exec output loops back eight nodes, so the graph is full of cycles. */
+	CyclicLoop,
+};
+
+/** Every shape, in declaration order. */
+static constexpr ECognitiveComplexitySyntheticShape AllSyntheticShapes[] =
+{
+	ECognitiveComplexitySyntheticShape::Chain,
+	ECognitiveComplexitySyntheticShape::BranchNest,
+	ECognitiveComplexitySyntheticShape::Mixed,
+	ECognitiveComplexitySyntheticShape::WideSequence,
+	ECognitiveComplexitySyntheticShape::SwitchFanOut,
+	ECognitiveComplexitySyntheticShape::CyclicLoop,
+};
+
+struct FCognitiveComplexitySyntheticGraphParams
+{
+	ECognitiveComplexitySyntheticShape Shape = ECognitiveComplexitySyntheticShape::Chain;
+	int32 NumEntries = 1;
+	int32 NodesPerEntry = 1000;
+};
+
+/**
+ * Builds transient Blueprints whose event graph has a chosen exec shape, for benchmarking the calculator.
+ * The node helpers are public so verification cases can lay out small graphs by hand.
+ *
+ * Nodes get their exec pins created by hand instead of through AllocateDefaultPins: only the
+ * topology and node classes matter to the calculator, and skipping reconstruction keeps
+ * generating million-node graphs cheap.
+ */
+class FCognitiveComplexitySyntheticGraph
+{
+public:
+	/** Creates a transient Blueprint with one event graph page holding the synthetic nodes. */
+	static UBlueprint* CreateBlueprint(const FCognitiveComplexitySyntheticGraphParams& Params);
+
+	/** Creates a transient Blueprint whose synthetic event graph page is still empty. */
+	static UBlueprint* CreateEmptyBlueprint();
+
+	/** Adds a node of the given class with only the requested exec pins. */
+	static UEdGraphNode* AddNode(UEdGraph* Graph, UClass* NodeClass, bool bHasExecInput, int32 NumExecOutputs);
+
+	/** Adds a custom event with one exec output. */
+	static UEdGraphNode* AddEntry(UEdGraph* Graph, int32 EntryIndex);
+
+	/** Links the OutputIndex-th exec output of From to the exec input of To. */
+	static void Link(UEdGraphNode* From, int32 OutputIndex, UEdGraphNode* To);
+
+	/** Adds an integer output pin to From and an integer input pin to To, and links them. */
+	static void LinkData(UEdGraphNode* From, UEdGraphNode* To);
+
+	/** Releases a Blueprint created by CreateBlueprint so the next GC can reclaim it. */
+	static void DestroyBlueprint(UBlueprint* Blueprint);
+
+	/** Returns the synthetic event graph of a Blueprint created by CreateBlueprint. */
+	static UEdGraph* GetGraph(const UBlueprint* Blueprint);
+
+	/** Returns the entry nodes of the synthetic graph in creation order. */
+	static TArray<const UEdGraphNode*> GetEntryNodes(const UBlueprint* Blueprint);
+
+	static bool ParseShape(const FString& InString, ECognitiveComplexitySyntheticShape& OutShape);
+	static const TCHAR* ShapeToString(ECognitiveComplexitySyntheticShape Shape);
+};
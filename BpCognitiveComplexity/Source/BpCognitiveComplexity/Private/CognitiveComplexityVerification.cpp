@@ -0,0 +1,654 @@
+// Copyright MurtazaHere, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BpCognitiveComplexitySettings.h"
+#include "CognitiveComplexityCalculator.h"
+#include "CognitiveComplexityCallGraph.h"
+#include "CognitiveComplexityFlatGraph.h"
+#include "CognitiveComplexitySnapshot.h"
+#include "CognitiveComplexitySyntheticGraph.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_SwitchInteger.h"
+#include "K2Node_Timeline.h"
+#include "K2Node_Tunnel.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectIterator.h"
+
+/**
+ * Score semantics tests for the calculator, run from the Session Frontend or with
+ * "Automation RunTests BpCognitiveComplexity".
+ *
+ * Golden cases lay out small graphs by hand and pin the exact RawScore and Percent that every
+ * scoring engine must produce for them under fixed weights, in the default, memoized, data-flow
+ * and callee-weighted modes. The differential test additionally scores every synthetic shape and
+ * every loaded Blueprint with each alternative engine and compares it against the reference
+ * recursive walk.
+ */
+namespace CognitiveComplexityVerification
+{
+	/** Builds the exec graph of a case behind its entry node. */
+	using FBuildCase = void(*)(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry);
+
+	struct FGoldenCase
+	{
+		const TCHAR* Name;
+
+		/** Expected score of the per-entry walk; the flat walk, the contribution walk and ProcessGraph must match it. */
+		float RawScore;
+		float Percent;
+
+		/** Expected score in memoized mode, which counts shared nodes once per depth they are reached at and scores a cycle at one depth. */
+		float MemoizedRawScore;
+		float MemoizedPercent;
+
+		FBuildCase Build;
+
+		/** Expected structural metrics, which every engine must report the same. */
+		FCognitiveComplexityMetrics Metrics;
+
+		/** Modes the case is scored with, in both the default and the memoized run. */
+		bool bWeightCallsByCallee = false;
+		bool bScoreDataFlow = false;
+	};
+
+	static UEdGraphNode* AddNode(UEdGraph& Graph, UClass* NodeClass, int32 NumExecOutputs = 1)
+	{
+		return FCognitiveComplexitySyntheticGraph::AddNode(&Graph, NodeClass, /*bHasExecInput*/true, NumExecOutputs);
+	}
+
+	static UEdGraphNode* AddCall(UEdGraph& Graph, int32 NumExecOutputs = 1)
+	{
+		return AddNode(Graph, UK2Node_CallFunction::StaticClass(), NumExecOutputs);
+	}
+
+	/** Macro graph of the Blueprint with an instance of it in Graph. */
+	static UK2Node_MacroInstance* AddMacro(UBlueprint& Blueprint, UEdGraph& Graph, const TCHAR* BaseName, int32 NumExecOutputs, UEdGraph*& OutMacroGraph)
+	{
+		const FName MacroName = MakeUniqueObjectName(&Blueprint, UEdGraph::StaticClass(), BaseName);
+		OutMacroGraph = FBlueprintEditorUtils::CreateNewGraph(&Blueprint, MacroName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		Blueprint.MacroGraphs.Add(OutMacroGraph);
+
+		UK2Node_MacroInstance* Instance = CastChecked<UK2Node_MacroInstance>(AddNode(Graph, UK2Node_MacroInstance::StaticClass(), NumExecOutputs));
+		Instance->SetMacroGraph(OutMacroGraph);
+		return Instance;
+	}
+
+	/** Function graph of the Blueprint, holding only its entry node. */
+	static UEdGraph* AddFunction(UBlueprint& Blueprint, const TCHAR* BaseName, UEdGraphNode*& OutEntry)
+	{
+		const FName FunctionName = MakeUniqueObjectName(&Blueprint, UEdGraph::StaticClass(), BaseName);
+		UEdGraph* FunctionGraph = FBlueprintEditorUtils::CreateNewGraph(&Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		Blueprint.FunctionGraphs.Add(FunctionGraph);
+
+		OutEntry = FCognitiveComplexitySyntheticGraph::AddNode(FunctionGraph, UK2Node_FunctionEntry::StaticClass(), /*bHasExecInput*/false, 1);
+		return FunctionGraph;
+	}
+
+	/** Call in Graph to a function graph of the same Blueprint. */
+	static UEdGraphNode* AddFunctionCall(UEdGraph& Graph, const UEdGraph& FunctionGraph)
+	{
+		UK2Node_CallFunction* Call = CastChecked<UK2Node_CallFunction>(AddCall(Graph));
+		Call->FunctionReference.SetSelfMember(FunctionGraph.GetFName());
+		return Call;
+	}
+
+	/** Macro instance of an empty macro graph named like the standard library ForLoop, which classifies it as a loop. */
+	static UEdGraphNode* AddLoopMacro(UBlueprint& Blueprint, UEdGraph& Graph)
+	{
+		UEdGraph* MacroGraph = nullptr;
+		return AddMacro(Blueprint, Graph, TEXT("ForLoop"), 2, MacroGraph);
+	}
+
+	/** Pure call with no exec pins. A FunctionName in UKismetMathLibrary makes it a math operator. */
+	static UEdGraphNode* AddPureCall(UEdGraph& Graph, FName FunctionName = NAME_None)
+	{
+		UK2Node_CallFunction* Call = CastChecked<UK2Node_CallFunction>(FCognitiveComplexitySyntheticGraph::AddNode(&Graph, UK2Node_CallFunction::StaticClass(), /*bHasExecInput*/false, 0));
+		Call->bIsPureFunc = true;
+		if (!FunctionName.IsNone())
+		{
+			Call->FunctionReference.SetExternalMember(FunctionName, UKismetMathLibrary::StaticClass());
+		}
+		return Call;
+	}
+
+	static void BuildBranch(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + Branch 2 + two calls at depth 1 (2 each) = 7.
+		UEdGraphNode* Branch = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Branch);
+		FCognitiveComplexitySyntheticGraph::Link(Branch, 0, AddCall(Graph));
+		FCognitiveComplexitySyntheticGraph::Link(Branch, 1, AddCall(Graph));
+	}
+
+	static void BuildLoop(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + Loop 3 + body and completed calls at depth 1 (2 each) = 8.
+		UEdGraphNode* Loop = AddLoopMacro(Blueprint, Graph);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Loop);
+		FCognitiveComplexitySyntheticGraph::Link(Loop, 0, AddCall(Graph));
+		FCognitiveComplexitySyntheticGraph::Link(Loop, 1, AddCall(Graph));
+	}
+
+	static void BuildSelect(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + Switch 1 + three case calls at depth 1 (2 each) = 8.
+		UEdGraphNode* Switch = AddNode(Graph, UK2Node_SwitchInteger::StaticClass(), 3);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Switch);
+		for (int32 Case = 0; Case < 3; ++Case)
+		{
+			FCognitiveComplexitySyntheticGraph::Link(Switch, Case, AddCall(Graph));
+		}
+	}
+
+	static void BuildLatent(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + Timeline 2 + call 1; latent nodes do not nest = 4.
+		UEdGraphNode* Timeline = AddNode(Graph, UK2Node_Timeline::StaticClass());
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Timeline);
+		FCognitiveComplexitySyntheticGraph::Link(Timeline, 0, AddCall(Graph));
+	}
+
+	static void BuildNesting(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + outer Branch 2 + inner Branch 2+1 + Switch 1+2 + call under the switch 1+3
+		// + inner else call 1+2 + outer else call 1+1 = 18.
+		UEdGraphNode* Outer = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		UEdGraphNode* Inner = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		UEdGraphNode* Switch = AddNode(Graph, UK2Node_SwitchInteger::StaticClass(), 1);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Outer);
+		FCognitiveComplexitySyntheticGraph::Link(Outer, 0, Inner);
+		FCognitiveComplexitySyntheticGraph::Link(Outer, 1, AddCall(Graph));
+		FCognitiveComplexitySyntheticGraph::Link(Inner, 0, Switch);
+		FCognitiveComplexitySyntheticGraph::Link(Inner, 1, AddCall(Graph));
+		FCognitiveComplexitySyntheticGraph::Link(Switch, 0, AddCall(Graph));
+	}
+
+	static void BuildSharedTail(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + Sequence 2 + three calls at depth 1 (2 each) = 9. Both paths reach the tail
+		// at depth 1, so memoized mode counts it once as well.
+		UEdGraphNode* Sequence = AddNode(Graph, UK2Node_ExecutionSequence::StaticClass(), 2);
+		UEdGraphNode* Left = AddCall(Graph);
+		UEdGraphNode* Right = AddCall(Graph);
+		UEdGraphNode* Tail = AddCall(Graph);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Sequence);
+		FCognitiveComplexitySyntheticGraph::Link(Sequence, 0, Left);
+		FCognitiveComplexitySyntheticGraph::Link(Sequence, 1, Right);
+		FCognitiveComplexitySyntheticGraph::Link(Left, 0, Tail);
+		FCognitiveComplexitySyntheticGraph::Link(Right, 0, Tail);
+	}
+
+	static void BuildTailAtTwoDepths(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + outer Branch 2 + inner Branch 2+1 + tail call under the inner Branch 1+2 = 9;
+		// the outer else reaches the tail again. Memoized mode also counts it at depth 1: 11.
+		UEdGraphNode* Outer = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		UEdGraphNode* Inner = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		UEdGraphNode* Tail = AddCall(Graph);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Outer);
+		FCognitiveComplexitySyntheticGraph::Link(Outer, 0, Inner);
+		FCognitiveComplexitySyntheticGraph::Link(Outer, 1, Tail);
+		FCognitiveComplexitySyntheticGraph::Link(Inner, 0, Tail);
+	}
+
+	static void BuildTailAtTwoDepthsShallowFirst(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Same links as TailAtTwoDepths, but the tail is created first, so the memoized walk
+		// reaches it over the shallow outer else before the inner Branch. Scores and metrics match.
+		UEdGraphNode* Outer = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		UEdGraphNode* Tail = AddCall(Graph);
+		UEdGraphNode* Inner = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Outer);
+		FCognitiveComplexitySyntheticGraph::Link(Outer, 0, Inner);
+		FCognitiveComplexitySyntheticGraph::Link(Outer, 1, Tail);
+		FCognitiveComplexitySyntheticGraph::Link(Inner, 0, Tail);
+	}
+
+	static void BuildDiamondChain(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Three Branches whose outputs both join on one call. Entry 1, then per diamond i the
+		// Branch 2+(i-1) and the join 1+i: 1 + 4 + 6 + 8 = 19. Every join is reached at a single
+		// depth, so memoized mode agrees instead of doubling per diamond.
+		UEdGraphNode* Previous = &Entry;
+		for (int32 Diamond = 0; Diamond < 3; ++Diamond)
+		{
+			UEdGraphNode* Branch = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+			UEdGraphNode* Join = AddCall(Graph);
+			FCognitiveComplexitySyntheticGraph::Link(Previous, 0, Branch);
+			FCognitiveComplexitySyntheticGraph::Link(Branch, 0, Join);
+			FCognitiveComplexitySyntheticGraph::Link(Branch, 1, Join);
+			Previous = Join;
+		}
+	}
+
+	static void BuildDataFlow(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + first call 1 + its inputs: an Add_IntInt (math 1) of a variable (math 1) and a
+		// pure call (call 2) + second call 1, whose input reuses the Add = 7. Memoized mode also
+		// counts each pure node once per entry.
+		UEdGraphNode* First = AddCall(Graph);
+		UEdGraphNode* Second = AddCall(Graph);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, First);
+		FCognitiveComplexitySyntheticGraph::Link(First, 0, Second);
+
+		UEdGraphNode* Add = AddPureCall(Graph, GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt));
+		FCognitiveComplexitySyntheticGraph::LinkData(FCognitiveComplexitySyntheticGraph::AddNode(&Graph, UK2Node_VariableGet::StaticClass(), /*bHasExecInput*/false, 0), Add);
+		FCognitiveComplexitySyntheticGraph::LinkData(AddPureCall(Graph), Add);
+		FCognitiveComplexitySyntheticGraph::LinkData(Add, First);
+		FCognitiveComplexitySyntheticGraph::LinkData(Add, Second);
+	}
+
+	static void BuildCalleeMacro(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// The macro body is two calls behind its entry tunnel, so it scores 2. Entry 1 + Branch 2
+		// + macro instance at depth 1 (0 + callee 2 + 1) + else call 1+1 = 8.
+		UEdGraph* MacroGraph = nullptr;
+		UEdGraphNode* Instance = AddMacro(Blueprint, Graph, TEXT("Helper"), 1, MacroGraph);
+
+		UK2Node_Tunnel* Tunnel = CastChecked<UK2Node_Tunnel>(FCognitiveComplexitySyntheticGraph::AddNode(MacroGraph, UK2Node_Tunnel::StaticClass(), /*bHasExecInput*/false, 1));
+		Tunnel->bCanHaveInputs = false;
+		Tunnel->bCanHaveOutputs = true;
+		UEdGraphNode* BodyCall = AddCall(*MacroGraph);
+		FCognitiveComplexitySyntheticGraph::Link(Tunnel, 0, BodyCall);
+		FCognitiveComplexitySyntheticGraph::Link(BodyCall, 0, AddCall(*MacroGraph));
+
+		UEdGraphNode* Branch = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Branch);
+		FCognitiveComplexitySyntheticGraph::Link(Branch, 0, Instance);
+		FCognitiveComplexitySyntheticGraph::Link(Branch, 1, AddCall(Graph));
+	}
+
+	static void BuildMutualRecursion(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// The event calls F, F calls G and G calls F back. Walking the callees from the event graph
+		// finds G's call to F closing the cycle, so it stays plain: G = 1+1 = 2, F = 1+1+2 = 4 and
+		// the event 1 + call 1 + F 4 = 6. As roots, F and G score the same as they do as callees.
+		UEdGraphNode* EntryF = nullptr;
+		UEdGraphNode* EntryG = nullptr;
+		UEdGraph* GraphF = AddFunction(Blueprint, TEXT("F"), EntryF);
+		UEdGraph* GraphG = AddFunction(Blueprint, TEXT("G"), EntryG);
+
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, AddFunctionCall(Graph, *GraphF));
+		FCognitiveComplexitySyntheticGraph::Link(EntryF, 0, AddFunctionCall(*GraphF, *GraphG));
+		FCognitiveComplexitySyntheticGraph::Link(EntryG, 0, AddFunctionCall(*GraphG, *GraphF));
+	}
+
+	static void BuildCycle(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + three calls 1 each; the back edge is never followed twice = 4.
+		UEdGraphNode* First = AddCall(Graph);
+		UEdGraphNode* Second = AddCall(Graph);
+		UEdGraphNode* Third = AddCall(Graph, 2);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, First);
+		FCognitiveComplexitySyntheticGraph::Link(First, 0, Second);
+		FCognitiveComplexitySyntheticGraph::Link(Second, 0, Third);
+		FCognitiveComplexitySyntheticGraph::Link(Third, 1, First);
+	}
+
+	static void BuildNestedCycle(UBlueprint& Blueprint, UEdGraph& Graph, UEdGraphNode& Entry)
+	{
+		// Entry 1 + Branch 2 + looping call 1+1 + else call 1+1 = 7. Memoized mode scores the
+		// Branch and the looping call as one component at the Branch's depth: 6.
+		UEdGraphNode* Branch = AddNode(Graph, UK2Node_IfThenElse::StaticClass(), 2);
+		UEdGraphNode* Body = AddCall(Graph);
+		FCognitiveComplexitySyntheticGraph::Link(&Entry, 0, Branch);
+		FCognitiveComplexitySyntheticGraph::Link(Branch, 0, Body);
+		FCognitiveComplexitySyntheticGraph::Link(Branch, 1, AddCall(Graph));
+		FCognitiveComplexitySyntheticGraph::Link(Body, 0, Branch);
+	}
+
+	static FCognitiveComplexityMetrics MakeMetrics(int32 Cyclomatic, int32 NodeCount, int32 MaxNesting, int32 MaxFanOut, int32 LatentCount)
+	{
+		FCognitiveComplexityMetrics Metrics;
+		Metrics.Cyclomatic = Cyclomatic;
+		Metrics.NodeCount = NodeCount;
+		Metrics.MaxNesting = MaxNesting;
+		Metrics.MaxFanOut = MaxFanOut;
+		Metrics.LatentCount = LatentCount;
+		return Metrics;
+	}
+
+	/** Cyclomatic is exec links minus exec nodes plus 2, so a branch whose paths never join counts 1. */
+	static const FGoldenCase GoldenCases[] =
+	{
+		{ TEXT("Branch"), 7.0f, 10.9375f, 7.0f, 10.9375f, &BuildBranch, MakeMetrics(1, 4, 1, 2, 0) },
+		{ TEXT("Loop"), 8.0f, 12.5f, 8.0f, 12.5f, &BuildLoop, MakeMetrics(1, 4, 1, 2, 0) },
+		{ TEXT("Select"), 8.0f, 12.5f, 8.0f, 12.5f, &BuildSelect, MakeMetrics(1, 5, 1, 3, 0) },
+		{ TEXT("Latent"), 4.0f, 6.25f, 4.0f, 6.25f, &BuildLatent, MakeMetrics(1, 3, 0, 1, 1) },
+		{ TEXT("Nesting"), 18.0f, 28.125f, 18.0f, 28.125f, &BuildNesting, MakeMetrics(1, 7, 3, 2, 0) },
+		{ TEXT("SharedTail"), 9.0f, 14.0625f, 9.0f, 14.0625f, &BuildSharedTail, MakeMetrics(2, 5, 1, 2, 0) },
+		{ TEXT("TailAtTwoDepths"), 9.0f, 14.0625f, 11.0f, 17.1875f, &BuildTailAtTwoDepths, MakeMetrics(2, 4, 2, 2, 0) },
+		{ TEXT("TailAtTwoDepthsShallowFirst"), 9.0f, 14.0625f, 11.0f, 17.1875f, &BuildTailAtTwoDepthsShallowFirst, MakeMetrics(2, 4, 2, 2, 0) },
+		{ TEXT("DiamondChain"), 19.0f, 29.6875f, 19.0f, 29.6875f, &BuildDiamondChain, MakeMetrics(4, 7, 3, 2, 0) },
+		{ TEXT("Cycle"), 4.0f, 6.25f, 4.0f, 6.25f, &BuildCycle, MakeMetrics(2, 4, 0, 1, 0) },
+		{ TEXT("NestedCycle"), 7.0f, 10.9375f, 6.0f, 9.375f, &BuildNestedCycle, MakeMetrics(2, 4, 1, 2, 0) },
+		{ TEXT("DataFlow"), 7.0f, 10.9375f, 7.0f, 10.9375f, &BuildDataFlow, MakeMetrics(1, 6, 0, 1, 0), /*bWeightCallsByCallee*/false, /*bScoreDataFlow*/true },
+		{ TEXT("CalleeMacro"), 8.0f, 12.5f, 8.0f, 12.5f, &BuildCalleeMacro, MakeMetrics(1, 4, 1, 2, 0), /*bWeightCallsByCallee*/true, /*bScoreDataFlow*/false },
+		{ TEXT("MutualRecursion"), 6.0f, 9.375f, 6.0f, 9.375f, &BuildMutualRecursion, MakeMetrics(1, 2, 0, 1, 0), /*bWeightCallsByCallee*/true, /*bScoreDataFlow*/false },
+	};
+
+	/**
+	 * The shipped default weights, independent of the project's configuration, except for a data-flow
+	 * call weight that tells pure calls from math. A power-of-two percent scale keeps every golden
+	 * Percent exactly representable.
+	 */
+	static TStrongObjectPtr<UBpCognitiveComplexitySettings> MakeGoldenSettings(const FGoldenCase& Case, bool bMemoizedScoring)
+	{
+		TStrongObjectPtr<UBpCognitiveComplexitySettings> Settings(NewObject<UBpCognitiveComplexitySettings>(GetTransientPackage(), NAME_None, RF_Transient));
+		Settings->BaseEntryWeight = 1;
+		Settings->BranchWeight = 2;
+		Settings->SelectWeight = 1;
+		Settings->LoopWeight = 3;
+		Settings->LatentWeight = 2;
+		Settings->FunctionCallWeight = 1;
+		Settings->MathNodeWeight = 1;
+		Settings->NestingPenalty = 1;
+		Settings->PercentScale = 64;
+		Settings->DataFlowMathWeight = 1;
+		Settings->DataFlowCallWeight = 2;
+		Settings->bMemoizedScoring = bMemoizedScoring;
+		Settings->bWeightCallsByCallee = Case.bWeightCallsByCallee;
+		Settings->bScoreDataFlow = Case.bScoreDataFlow;
+		return Settings;
+	}
+
+	/**
+	 * The project's weights with the optional modes off, under which every engine must agree with the
+	 * reference walk. New instances start as a copy of the class default object, which holds the config.
+	 */
+	static TStrongObjectPtr<UBpCognitiveComplexitySettings> MakeReferenceSettings()
+	{
+		TStrongObjectPtr<UBpCognitiveComplexitySettings> Settings(NewObject<UBpCognitiveComplexitySettings>(GetTransientPackage(), NAME_None, RF_Transient));
+		Settings->bMemoizedScoring = false;
+		Settings->bWeightCallsByCallee = false;
+		return Settings;
+	}
+
+	static float SumContributions(const TArray<FCognitiveComplexityNodeContribution>& Contributions)
+	{
+		float Total = 0.0f;
+		for (const FCognitiveComplexityNodeContribution& Contribution : Contributions)
+		{
+			Total += Contribution.GetTotal();
+		}
+		return Total;
+	}
+
+	/** Engines may sum in a different order than the reference walk, so compare with a relative tolerance. */
+	static float GetTolerance(float Reference)
+	{
+		return KINDA_SMALL_NUMBER * FMath::Max(1.0f, FMath::Abs(Reference));
+	}
+
+	/** Checks that the features of a single processed entry evaluate to Expected, and scale with doubled weights. */
+	static void CheckFeatures(FAutomationTestBase& Test, const TArray<FCognitiveComplexityEntryResult>& Processed, FCognitiveComplexityWeights Weights, const FString& Label, const TCHAR* Engine, float Expected)
+	{
+		if (!Test.TestTrue(FString::Printf(TEXT("%s: %s has features"), *Label, Engine), Processed.Num() == 1 && Processed[0].bHasFeatures))
+		{
+			return;
+		}
+
+		const FCognitiveComplexityFeatures& Features = Processed[0].Features;
+		Test.TestEqual(FString::Printf(TEXT("%s: %s"), *Label, Engine), Features.GetRawScore(Weights), Expected, 0.0f);
+
+		for (float& Weight : Weights.Categories)
+		{
+			Weight *= 2.0f;
+		}
+		Weights.NestingPenalty *= 2.0f;
+		Weights.DataFlowMath *= 2.0f;
+		Weights.DataFlowCall *= 2.0f;
+
+		// Callee scores are baked in with the weights they were computed under and do not scale.
+		Test.TestEqual(FString::Printf(TEXT("%s: %s re-weighted"), *Label, Engine), Features.GetRawScore(Weights), 2.0f * Expected - Features.CalleeScore, 0.0f);
+	}
+
+	/** Checks the metrics of a single processed entry against the case's golden values, field by field. */
+	static void CheckMetrics(FAutomationTestBase& Test, const TArray<FCognitiveComplexityEntryResult>& Processed, const FGoldenCase& Case, const TCHAR* Engine)
+	{
+		if (!Test.TestTrue(FString::Printf(TEXT("%s: %s has metrics"), Case.Name, Engine), Processed.Num() == 1 && Processed[0].bHasMetrics))
+		{
+			return;
+		}
+
+		const FCognitiveComplexityMetrics& Metrics = Processed[0].Metrics;
+		Test.TestEqual(FString::Printf(TEXT("%s: %s cyclomatic"), Case.Name, Engine), Metrics.Cyclomatic, Case.Metrics.Cyclomatic);
+		Test.TestEqual(FString::Printf(TEXT("%s: %s node count"), Case.Name, Engine), Metrics.NodeCount, Case.Metrics.NodeCount);
+		Test.TestEqual(FString::Printf(TEXT("%s: %s max nesting"), Case.Name, Engine), Metrics.MaxNesting, Case.Metrics.MaxNesting);
+		Test.TestEqual(FString::Printf(TEXT("%s: %s max fan-out"), Case.Name, Engine), Metrics.MaxFanOut, Case.Metrics.MaxFanOut);
+		Test.TestEqual(FString::Printf(TEXT("%s: %s latent count"), Case.Name, Engine), Metrics.LatentCount, Case.Metrics.LatentCount);
+	}
+
+	/** Score of the only processed entry, or -1 if there is not exactly one. */
+	static float GetSingleScore(const TArray<FCognitiveComplexityEntryResult>& Processed)
+	{
+		return Processed.Num() == 1 ? Processed[0].Score.RawScore : -1.0f;
+	}
+
+	/**
+	 * Checks that snapshots of the whole Blueprint score every entry like ProcessBlueprint, with an
+	 * empty call graph and again once it adopted what the first snapshot resolved. Which call closes
+	 * a recursion depends on the order callees are walked in, so both paths must walk alike.
+	 */
+	static void CheckBlueprintSnapshots(FAutomationTestBase& Test, const UBlueprint& Blueprint, const UBpCognitiveComplexitySettings& Settings, const FString& Label)
+	{
+		const TArray<FCognitiveComplexityEntryResult> Processed = FCognitiveComplexityCalculator(Settings).ProcessBlueprint(&Blueprint);
+
+		FCognitiveComplexityCallGraph CallGraph;
+		FCognitiveComplexityCalculator Calculator(Settings);
+		Calculator.SetCallGraph(&CallGraph);
+
+		for (const TCHAR* Pass : { TEXT("Blueprint snapshot"), TEXT("Blueprint snapshot after adopting") })
+		{
+			FCognitiveComplexitySnapshot Snapshot = Calculator.CaptureBlueprint(&Blueprint);
+			Calculator.ResolveCallees(Snapshot);
+			const TArray<FCognitiveComplexityEntryResult> SnapshotProcessed = Calculator.ProcessSnapshot(Snapshot);
+			CallGraph.Adopt(Snapshot.ResolvedCallees);
+
+			if (!Test.TestEqual(FString::Printf(TEXT("%s: %s entries"), *Label, Pass), SnapshotProcessed.Num(), Processed.Num()))
+			{
+				continue;
+			}
+
+			for (int32 Index = 0; Index < Processed.Num(); ++Index)
+			{
+				Test.TestEqual(FString::Printf(TEXT("%s: %s entry '%s'"), *Label, Pass, *Processed[Index].EntryDisplayName), SnapshotProcessed[Index].Score.RawScore, Processed[Index].Score.RawScore, 0.0f);
+			}
+		}
+	}
+
+	/** Scores one golden case with every engine. Golden values are small integers, which every engine must reproduce exactly. */
+	static void RunGoldenCase(FAutomationTestBase& Test, const FGoldenCase& Case)
+	{
+		UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateEmptyBlueprint();
+		UEdGraph* Graph = FCognitiveComplexitySyntheticGraph::GetGraph(Blueprint);
+		if (!Test.TestNotNull(FString::Printf(TEXT("%s: synthetic graph"), Case.Name), Graph))
+		{
+			FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+			return;
+		}
+
+		UEdGraphNode* Entry = FCognitiveComplexitySyntheticGraph::AddEntry(Graph, 0);
+		Case.Build(*Blueprint, *Graph, *Entry);
+
+		const TStrongObjectPtr<UBpCognitiveComplexitySettings> Settings = MakeGoldenSettings(Case, /*bMemoizedScoring*/false);
+		const TStrongObjectPtr<UBpCognitiveComplexitySettings> MemoizedSettings = MakeGoldenSettings(Case, /*bMemoizedScoring*/true);
+		const FString Label = Case.Name;
+		auto What = [&Label](const TCHAR* Engine) { return FString::Printf(TEXT("%s: %s"), *Label, Engine); };
+
+		// The reference walk only weighs calls by their callee with a resolved call graph.
+		FCognitiveComplexityCallGraph CallGraph;
+		FCognitiveComplexityCalculator Calculator(*Settings);
+		Calculator.SetCallGraph(&CallGraph);
+		if (Case.bWeightCallsByCallee)
+		{
+			CallGraph.Resolve(Blueprint, Calculator);
+		}
+
+		const FCognitiveComplexityScore Reference = Calculator.Calculate(*Entry);
+		Test.TestEqual(What(TEXT("reference walk")), Reference.RawScore, Case.RawScore, 0.0f);
+		Test.TestEqual(What(TEXT("reference walk percent")), Reference.Percent, Case.Percent, 0.0f);
+
+		const UEdGraph* ConstGraph = Graph;
+		const FCognitiveComplexityFlatGraph FlatGraph = FCognitiveComplexityFlatGraph::Build(MakeArrayView(&ConstGraph, 1), Case.bWeightCallsByCallee ? &CallGraph : nullptr);
+		Test.TestEqual(What(TEXT("flat walk")), Calculator.Calculate(FlatGraph, FlatGraph.EntryIndices[0]).RawScore, Case.RawScore, 0.0f);
+
+		FCognitiveComplexityCalculator MemoizedCalculator(*MemoizedSettings);
+		const FCognitiveComplexityScore Memoized = MemoizedCalculator.CalculateMemoized(FlatGraph)[0];
+		Test.TestEqual(What(TEXT("memoized")), Memoized.RawScore, Case.MemoizedRawScore, 0.0f);
+		Test.TestEqual(What(TEXT("memoized percent")), Memoized.Percent, Case.MemoizedPercent, 0.0f);
+
+		TArray<FCognitiveComplexityNodeContribution> Contributions;
+		Test.TestEqual(What(TEXT("contribution walk")), Calculator.Calculate(*Entry, Contributions).RawScore, Case.RawScore, 0.0f);
+		Test.TestEqual(What(TEXT("contribution sum")), SumContributions(Contributions), Case.RawScore, 0.0f);
+
+		Test.TestEqual(What(TEXT("memoized contribution walk")), MemoizedCalculator.Calculate(*Entry, Contributions).RawScore, Case.MemoizedRawScore, 0.0f);
+		Test.TestEqual(What(TEXT("memoized contribution sum")), SumContributions(Contributions), Case.MemoizedRawScore, 0.0f);
+
+		const TArray<FCognitiveComplexityEntryResult> Processed = Calculator.ProcessGraph(Graph);
+		Test.TestEqual(What(TEXT("ProcessGraph")), GetSingleScore(Processed), Case.RawScore, 0.0f);
+
+		// Recorded features must reproduce the score, and scale with the weights without another walk.
+		const TArray<FCognitiveComplexityEntryResult> MemoizedProcessed = MemoizedCalculator.ProcessGraph(Graph);
+		CheckFeatures(Test, Processed, Settings->GetWeights(), Label, TEXT("features"), Case.RawScore);
+		CheckFeatures(Test, MemoizedProcessed, MemoizedSettings->GetWeights(), Label, TEXT("memoized features"), Case.MemoizedRawScore);
+		CheckMetrics(Test, Processed, Case, TEXT("ProcessGraph"));
+		CheckMetrics(Test, MemoizedProcessed, Case, TEXT("memoized ProcessGraph"));
+
+		// Snapshots are what the badges and the scanner score off the game thread. The memoized
+		// calculator has no call graph, so its snapshot captures the callees and scores them itself.
+		FCognitiveComplexitySnapshot Snapshot = Calculator.CaptureGraph(Graph);
+		Calculator.ResolveCallees(Snapshot);
+		const TArray<FCognitiveComplexityEntryResult> SnapshotProcessed = Calculator.ProcessSnapshot(Snapshot);
+		Test.TestEqual(What(TEXT("snapshot")), GetSingleScore(SnapshotProcessed), Case.RawScore, 0.0f);
+		CheckMetrics(Test, SnapshotProcessed, Case, TEXT("snapshot"));
+
+		FCognitiveComplexitySnapshot MemoizedSnapshot = MemoizedCalculator.CaptureGraph(Graph);
+		MemoizedCalculator.ResolveCallees(MemoizedSnapshot);
+		const TArray<FCognitiveComplexityEntryResult> MemoizedSnapshotProcessed = MemoizedCalculator.ProcessSnapshot(MemoizedSnapshot);
+		Test.TestEqual(What(TEXT("memoized snapshot")), GetSingleScore(MemoizedSnapshotProcessed), Case.MemoizedRawScore, 0.0f);
+		CheckMetrics(Test, MemoizedSnapshotProcessed, Case, TEXT("memoized snapshot"));
+
+		Test.TestEqual(What(TEXT("snapshot contribution walk")), Calculator.Calculate(Snapshot.Graph, Snapshot.Graph.EntryIndices[0], Contributions).RawScore, Case.RawScore, 0.0f);
+		Test.TestEqual(What(TEXT("snapshot contribution sum")), SumContributions(Contributions), Case.RawScore, 0.0f);
+
+		if (Case.bWeightCallsByCallee)
+		{
+			CheckBlueprintSnapshots(Test, *Blueprint, *Settings, Label);
+			CheckBlueprintSnapshots(Test, *Blueprint, *MemoizedSettings, Label + TEXT(" (memoized)"));
+		}
+
+		FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+	}
+
+	/**
+	 * Scores every entry of the given graphs with the reference walk and checks that each engine
+	 * that must agree with it does.
+	 */
+	static void CompareWithReference(FAutomationTestBase& Test, const FCognitiveComplexityCalculator& Calculator, TConstArrayView<const UEdGraph*> Graphs, const FString& Label)
+	{
+		const FCognitiveComplexityFlatGraph FlatGraph = FCognitiveComplexityFlatGraph::Build(Graphs);
+
+		// Same numbering as FCognitiveComplexityFlatGraph::Build.
+		TArray<const UEdGraphNode*> Nodes;
+		for (const UEdGraph* Graph : Graphs)
+		{
+			if (Graph == nullptr)
+			{
+				continue;
+			}
+
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (Node != nullptr)
+				{
+					Nodes.Add(Node);
+				}
+			}
+		}
+
+		TArray<FCognitiveComplexityNodeContribution> Contributions;
+		for (const int32 EntryIndex : FlatGraph.EntryIndices)
+		{
+			const UEdGraphNode& Entry = *Nodes[EntryIndex];
+			const float Reference = Calculator.Calculate(Entry).RawScore;
+			const float Flat = Calculator.Calculate(FlatGraph, EntryIndex).RawScore;
+			const float Recorded = Calculator.Calculate(Entry, Contributions).RawScore;
+
+			const FString EntryLabel = FString::Printf(TEXT("%s: entry '%s'"), *Label, *Entry.GetNodeTitle(ENodeTitleType::ListView).ToString());
+			Test.TestEqual(EntryLabel + TEXT(" flat walk"), Flat, Reference, GetTolerance(Reference));
+			Test.TestEqual(EntryLabel + TEXT(" contribution walk"), Recorded, Reference, GetTolerance(Reference));
+			Test.TestEqual(EntryLabel + TEXT(" contribution sum"), SumContributions(Contributions), Reference, GetTolerance(Reference));
+		}
+	}
+
+	/** Compares every engine with the reference walk on each synthetic shape and every loaded Blueprint. */
+	static void RunDifferential(FAutomationTestBase& Test)
+	{
+		const TStrongObjectPtr<UBpCognitiveComplexitySettings> Settings = MakeReferenceSettings();
+		const FCognitiveComplexityCalculator Calculator(*Settings);
+
+		for (const ECognitiveComplexitySyntheticShape Shape : AllSyntheticShapes)
+		{
+			FCognitiveComplexitySyntheticGraphParams Params;
+			Params.Shape = Shape;
+			Params.NumEntries = 8;
+			Params.NodesPerEntry = 500;
+
+			UBlueprint* Blueprint = FCognitiveComplexitySyntheticGraph::CreateBlueprint(Params);
+			const UEdGraph* Graph = FCognitiveComplexitySyntheticGraph::GetGraph(Blueprint);
+			CompareWithReference(Test, Calculator, MakeArrayView(&Graph, 1), FCognitiveComplexitySyntheticGraph::ShapeToString(Shape));
+			FCognitiveComplexitySyntheticGraph::DestroyBlueprint(Blueprint);
+		}
+
+		for (TObjectIterator<UBlueprint> It; It; ++It)
+		{
+			const UBlueprint* Blueprint = *It;
+			if (Blueprint->HasAnyFlags(RF_ClassDefaultObject | RF_Transient))
+			{
+				continue;
+			}
+
+			TArray<const UEdGraph*, TInlineAllocator<16>> Graphs;
+			Graphs.Append(Blueprint->UbergraphPages);
+			Graphs.Append(Blueprint->FunctionGraphs);
+
+			CompareWithReference(Test, Calculator, Graphs, Blueprint->GetPathName());
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCognitiveComplexityGoldenScoresTest, "BpCognitiveComplexity.Scoring.GoldenScores", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCognitiveComplexityGoldenScoresTest::RunTest(const FString& Parameters)
+{
+	for (const CognitiveComplexityVerification::FGoldenCase& Case : CognitiveComplexityVerification::GoldenCases)
+	{
+		CognitiveComplexityVerification::RunGoldenCase(*this, Case);
+	}
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCognitiveComplexityDifferentialTest, "BpCognitiveComplexity.Scoring.Differential", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCognitiveComplexityDifferentialTest::RunTest(const FString& Parameters)
+{
+	CognitiveComplexityVerification::RunDifferential(*this);
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -7,6 +7,8 @@
 
 enum class ECheckBoxState : uint8;
 
+DECLARE_LOG_CATEGORY_EXTERN(LogBpCognitiveComplexity, Log, All);
+
 class FBpCognitiveComplexityModule : public IModuleInterface
 {
 public:
@@ -23,18 +25,50 @@ public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 	
-	FCognitiveComplexityScore GetScoreForNode(const class UEdGraphNode& Node) const;
+	/** Last score of an entry node; a stale score is rescored in the background. Unset until the first score lands. */
+	TOptional<FCognitiveComplexityScore> GetScoreForNode(const class UEdGraphNode& Node) const;
 	void InvalidateBlueprint(class UBlueprint* Blueprint);
 	bool GetShowEntryBadges() const { return bShowEntryBadges; }
 	void ToggleShowEntryBadges();
 	FString GetComplexityLabelForPercent(float Percent, const class UBpCognitiveComplexitySettings* Settings) const;
 	ECheckBoxState GetShowEntryBadgesCheckState() const;
+	bool GetShowHeatmap() const { return bShowHeatmap; }
+	void ToggleShowHeatmap();
+	ECheckBoxState GetShowHeatmapCheckState() const;
+
+	/** Largest score contribution of a node across its graph's entries, and the graph's largest contribution. */
+	bool GetNodeContribution(const class UEdGraphNode& Node, FCognitiveComplexityNodeContribution& OutContribution, float& OutGraphMaxContribution) const;
+
+	/** Bumped whenever a cached score changes, so per-widget heatmap layouts know when to look up again. */
+	uint32 GetContributionGeneration() const;
+
+	/** Bumped on every settings change, so per-widget badge layouts know when to rebuild. */
+	uint32 GetSettingsGeneration() const { return SettingsGeneration; }
+
+	/** Dashboard results persisted across editor sessions. */
+	TSharedPtr<class FCognitiveComplexityResultCache> GetResultCache() const { return ResultCache; }
 
 private:
+	/** Subscribes to the editor's Blueprint compile and asset editor events; GEditor does not exist yet when the module starts. */
+	void BindEditorEvents();
+	void HandleAssetClosedInEditor(class UObject* Asset, class IAssetEditorInstance* Instance);
+	void HandleBlueprintPreCompile(class UBlueprint* Blueprint);
+	void HandleBlueprintsCompiled();
 	void HandleBlueprintCompiled(class UBlueprint* Blueprint);
+	void HandleSettingsChanged();
 	
 	TSharedPtr<class FCognitiveComplexityNodeFactory> NodeFactory;
-	mutable TMap<FGuid, FCognitiveComplexityScore> CachedScores;
+	TSharedPtr<class FCognitiveComplexityScoreCache> ScoreCache;
+	TSharedPtr<class FCognitiveComplexityResultCache> ResultCache;
+	FDelegateHandle PreCompileHandle;
 	FDelegateHandle CompileHandle;
+	FDelegateHandle AssetClosedHandle;
+	FDelegateHandle PostEngineInitHandle;
+
+	/** Blueprints announced by the pre-compile event; the compiled event is broadcast once per batch and does not name them. */
+	TArray<TWeakObjectPtr<class UBlueprint>> CompilingBlueprints;
+	FDelegateHandle SettingsChangedHandle;
 	bool bShowEntryBadges = true;
+	bool bShowHeatmap = false;
+	uint32 SettingsGeneration = 1;
 };
@@ -3,8 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CognitiveComplexityTypes.h"
+#include "UObject/SoftObjectPtr.h"
 #include "BpCognitiveComplexitySettings.generated.h"
 
+class UBlueprint;
+
 /**
  * User-configurable weights for the Blueprint cognitive complexity meter.
  *
@@ -19,10 +23,32 @@ class UBpCognitiveComplexitySettings : public UObject
 public:
 	static const UBpCognitiveComplexitySettings* Get();
 
+	/** Stable hash of every setting that affects scores. Persisted results computed with a different hash are discarded. */
+	uint32 GetScoringHash() const;
+
+	/**
+	 * Stable hash of the settings that decide which nodes are counted and how, i.e. everything in
+	 * GetScoringHash except the linear weights. Features recorded under the same hash can be
+	 * re-weighted instead of rescored.
+	 */
+	uint32 GetFeatureHash() const;
+
+	/** The weight settings as one weight vector. */
+	FCognitiveComplexityWeights GetWeights() const;
+
+	/** Copies a weight vector back into the weight settings, rounding to whole weights. */
+	void SetWeights(const FCognitiveComplexityWeights& Weights);
+
 #if WITH_EDITOR
 	FText GetSectionText() const;
 	FText GetSectionDescription() const;
 	FName GetCategoryName() const;
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	/** Broadcast after any setting is edited so cached scores can be invalidated. */
+	DECLARE_MULTICAST_DELEGATE(FOnSettingsChanged);
+	static FOnSettingsChanged& OnSettingsChanged();
 #endif
 
 public:
@@ -58,6 +84,39 @@ public:
 	UPROPERTY(EditAnywhere, config, Category="Weights", meta=(ClampMin="0"))
 	int32 NestingPenalty = 1;
 
+	/**
+	 * Score the exec graph on its strongly connected components, condensed once per graph and
+	 * shared by all of its entries. Each entry still walks the components it reaches on its own.
+	 * A chain several paths converge on is counted once for each nesting depth it is reached at,
+	 * so results no longer depend on pin order and converging paths cannot make the score grow
+	 * exponentially.
+	 */
+	UPROPERTY(EditAnywhere, config, Category="Weights")
+	bool bMemoizedScoring = false;
+
+	/**
+	 * Weight calls to Blueprint functions (local or inherited) and macro instances by the callee's
+	 * own score on top of FunctionCallWeight, so hiding logic in a function does not hide its cost.
+	 * Each callee is scored once per scan; recursive calls count as plain calls.
+	 */
+	UPROPERTY(EditAnywhere, config, Category="Weights")
+	bool bWeightCallsByCallee = false;
+
+	/**
+	 * Also score the pure expressions (math, conversions, variable reads, pure calls) feeding the
+	 * inputs of every reached exec node. Each pure node counts once per entry.
+	 */
+	UPROPERTY(EditAnywhere, config, Category="Data Flow")
+	bool bScoreDataFlow = false;
+
+	/** Pure math/data nodes feeding an exec node, including pure math-library operators and conversions. */
+	UPROPERTY(EditAnywhere, config, Category="Data Flow", meta=(ClampMin="0", EditCondition="bScoreDataFlow"))
+	int32 DataFlowMathWeight = 1;
+
+	/** Other pure function calls feeding an exec node. */
+	UPROPERTY(EditAnywhere, config, Category="Data Flow", meta=(ClampMin="0", EditCondition="bScoreDataFlow"))
+	int32 DataFlowCallWeight = 1;
+
 	/** Converts raw score to percent: Percent = Score / PercentScale * 100. */
 	UPROPERTY(EditAnywhere, config, Category="Display", meta=(ClampMin="1"))
 	int32 PercentScale = 100;
@@ -74,4 +133,37 @@ public:
 
 	UPROPERTY(EditAnywhere, config, Category="Display", meta=(ClampMin="0"))
 	int32 RedThreshold = 100;
+
+	/**
+	 * Most node contributions the graph editor keeps cached for badges and the heatmap. Past it,
+	 * the Blueprints painted least recently are dropped and rescored when painted again. Blueprints open
+	 * in an asset editor or painted in the last few frames are kept, so the limit may be exceeded.
+	 * 0 keeps everything.
+	 */
+	UPROPERTY(EditAnywhere, config, Category="Display", meta=(ClampMin="0"))
+	int32 ScoreCacheMaxNodes = 200000;
+
+	/**
+	 * Load, score and release Blueprints in batches during dashboard scans. The packages a batch
+	 * loaded lose RF_Standalone and garbage is collected before the next batch, so a full project
+	 * scan never keeps every Blueprint in memory at once.
+	 */
+	UPROPERTY(EditAnywhere, config, Category="Scanning")
+	bool bStreamingScan = true;
+
+	/** Blueprints loaded per batch in streaming scans. Also the default -BatchSize of the commandlet. */
+	UPROPERTY(EditAnywhere, config, Category="Scanning", meta=(ClampMin="1", EditCondition="bStreamingScan"))
+	int32 ScanBatchSize = 64;
+
+	/** Macro libraries whose macros all count as loops. Engine ForLoop/ForEach/While macros are always loops. */
+	UPROPERTY(EditAnywhere, config, Category="Macros")
+	TArray<TSoftObjectPtr<UBlueprint>> LoopMacroLibraries;
+
+	/** Macro libraries whose macros all count as branches. */
+	UPROPERTY(EditAnywhere, config, Category="Macros")
+	TArray<TSoftObjectPtr<UBlueprint>> BranchMacroLibraries;
+
+	/** Macro libraries whose macros all count as latent nodes. */
+	UPROPERTY(EditAnywhere, config, Category="Macros")
+	TArray<TSoftObjectPtr<UBlueprint>> LatentMacroLibraries;
 };
@@ -10,9 +10,120 @@ struct FCognitiveComplexityScore
 	float Percent = 0.0f;
 };
 
+/** Every weight a score is linear in, as configured by UBpCognitiveComplexitySettings::GetWeights. */
+struct FCognitiveComplexityWeights
+{
+	static constexpr int32 NumCategories = 7;
+
+	/** Indexed by the bit position of each node category: entry, branch, select, loop, latent, function call, math. */
+	float Categories[NumCategories] = {};
+	float NestingPenalty = 0.0f;
+	float DataFlowMath = 0.0f;
+	float DataFlowCall = 0.0f;
+	float PercentScale = 100.0f;
+};
+
+/**
+ * What an entry's score is made of, independent of the weights: how many reached nodes carry each
+ * category, their summed nesting depth and the pure nodes counted by the data-flow pass. Scoring
+ * the entry under other weights is a dot product with these instead of another traversal.
+ */
+struct FCognitiveComplexityFeatures
+{
+	float CategoryCounts[FCognitiveComplexityWeights::NumCategories] = {};
+	float DepthSum = 0.0f;
+	float DataFlowMathCount = 0.0f;
+	float DataFlowCallCount = 0.0f;
+
+	/** Callee scores added to call sites. They were computed under the scan's weights and are not re-weighted. */
+	float CalleeScore = 0.0f;
+
+	FCognitiveComplexityFeatures& operator+=(const FCognitiveComplexityFeatures& Other)
+	{
+		for (int32 Index = 0; Index < FCognitiveComplexityWeights::NumCategories; ++Index)
+		{
+			CategoryCounts[Index] += Other.CategoryCounts[Index];
+		}
+		DepthSum += Other.DepthSum;
+		DataFlowMathCount += Other.DataFlowMathCount;
+		DataFlowCallCount += Other.DataFlowCallCount;
+		CalleeScore += Other.CalleeScore;
+		return *this;
+	}
+
+	float GetRawScore(const FCognitiveComplexityWeights& Weights) const
+	{
+		float RawScore = CalleeScore + Weights.NestingPenalty * DepthSum + Weights.DataFlowMath * DataFlowMathCount + Weights.DataFlowCall * DataFlowCallCount;
+		for (int32 Index = 0; Index < FCognitiveComplexityWeights::NumCategories; ++Index)
+		{
+			RawScore += Weights.Categories[Index] * CategoryCounts[Index];
+		}
+		return RawScore;
+	}
+
+	FCognitiveComplexityScore Evaluate(const FCognitiveComplexityWeights& Weights) const
+	{
+		FCognitiveComplexityScore Score;
+		Score.RawScore = GetRawScore(Weights);
+		Score.Percent = (Score.RawScore / Weights.PercentScale) * 100.0f;
+		return Score;
+	}
+};
+
+/** Structural metrics of the graph reachable from an entry, collected by the same walk as the score. */
+struct FCognitiveComplexityMetrics
+{
+	/** McCabe complexity of the reached exec graph: exec links - exec nodes + 2. */
+	int32 Cyclomatic = 0;
+
+	/** Exec nodes reached, plus the pure nodes counted when the data-flow pass is on. */
+	int32 NodeCount = 0;
+
+	/** Deepest nesting level any reached node sits at. */
+	int32 MaxNesting = 0;
+
+	/** Most exec links leaving a single reached node. */
+	int32 MaxFanOut = 0;
+
+	/** Reached latent nodes. */
+	int32 LatentCount = 0;
+};
+
+/** What one node added to the score of an entry it was reached from. */
+struct FCognitiveComplexityNodeContribution
+{
+	FGuid NodeGuid;
+	/** Base entry weight, non-zero only for the entry node itself. */
+	float BaseWeight = 0.0f;
+	/** Weights of the node's categories other than Entry. */
+	float CategoryWeight = 0.0f;
+	/** Nesting penalty for the depth the node was reached at. */
+	float NestingPenalty = 0.0f;
+	/** Data-flow weight of a pure node feeding a reached exec node, when the data-flow pass is on. */
+	float DataFlowWeight = 0.0f;
+
+	float GetTotal() const { return BaseWeight + CategoryWeight + NestingPenalty + DataFlowWeight; }
+};
+
 struct FCognitiveComplexityEntryResult
 {
 	FGuid NodeGuid;
 	FString EntryDisplayName;
 	FCognitiveComplexityScore Score;
+
+	/** Set when the entry was scored in this session or read back from the result cache; asset tags only hold scores. */
+	FCognitiveComplexityFeatures Features;
+	bool bHasFeatures = false;
+
+	/** Set under the same conditions as the features. */
+	FCognitiveComplexityMetrics Metrics;
+	bool bHasMetrics = false;
+};
+
+struct FCognitiveComplexityBlueprintResult
+{
+	FString BlueprintName;
+	FString BlueprintPath;
+	FName PackageName;
+	TArray<FCognitiveComplexityEntryResult> Entries;
 };
\ No newline at end of file